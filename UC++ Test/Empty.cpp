@@ -5,6 +5,8 @@ using namespace std;
 using namespace UC::IntLiterals;
 
 UCRegister( Empty );
+UCRegister( DerivedEmpty );
+UCRegister( MoreDerivedEmpty );
 
 UCCtor( Empty::Empty )
 {
@@ -35,6 +37,12 @@ UCMethod( Empty::Do , ( _1 , _2 ) )
 	return 2_i16;
 }
 
+UCMethod( DerivedEmpty::Reset )
+{
+	cout << "0 parameters for " __FUNCTION__ << endl;
+	return nullptr;
+}
+
 int Empty::NativeFunction( ) { std::cout << "From native function:" __FUNCTION__ << std::endl; return 0; }
 
 int NEmpty::NativeBaseFunction( ) { std::cout << "From native function in base:" __FUNCTION__ << std::endl; return 0; }
@@ -22,3 +22,27 @@ int NativeFunction( );
 
 UCEndInterface;
 
+
+UCInterface( DerivedEmpty ,
+			 UC_WhereTypenameIsRealName ,
+			 UC_InheritsUCClasses( Empty ) ,
+			 UC_InheritsNoNativeClasses
+)
+UC_OnlyHasEmptyCtor;
+UC_HasMethods(
+( Reset )
+);
+protected:
+	DerivedEmpty( ) = default;
+UCEndInterface;
+
+UCInterface( MoreDerivedEmpty ,
+			 UC_WhereTypenameIsRealName ,
+			 UC_InheritsUCClasses( DerivedEmpty ) ,
+			 UC_InheritsNoNativeClasses
+)
+UC_OnlyHasEmptyCtor;
+UC_HasNoMethods;
+protected:
+	MoreDerivedEmpty( ) = default;
+UCEndInterface;
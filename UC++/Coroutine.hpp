@@ -34,6 +34,7 @@ namespace UC
 		UCInterface( Coroutine , UC_WhereTypenameIs( "UC::Coro::Coroutine" ) , UC_InheritsUCClasses( YieldInstruction ) , UC_InheritsNoNativeClasses );
 		UC_OnlyHasNativeCtors;
 		UC_HasNoMethods;
+		UC_HasGCEdges( __instruction , __onStop );
 	public:
 		GeneratorForCoroutine __fiber;
 		P<YieldInstruction> __instruction;
@@ -199,7 +200,7 @@ namespace UC
 					return false;
 			return true;
 		}
-		template<typename... Ts> static pself MakeI( Ts && ... vs ) { return pself( new self{ std::forward<Ts>( vs )... } ); }
+		template<typename... Ts> static pself MakeI( Ts && ... vs ) { return ::UC::_Detail::MakeGC<self>( std::initializer_list<P<YieldInstruction>>{ std::forward<Ts>( vs )... } ); }
 	protected:
 		NatVector<P<YieldInstruction>> coros;
 		WaitForAll( std::initializer_list<P<YieldInstruction>> ilst ) :coros( ilst ) { }
@@ -12,31 +12,50 @@ __UCNothing)(tup)
 
 #define __UCMethodParamsHelper(r, data, i, elem) BOOST_PP_COMMA_IF(i) ::UC::P<Object> elem
 #define __UCMethodParams(list) BOOST_PP_LIST_FOR_EACH_I(__UCMethodParamsHelper,_,list)
-#define __UCWriteEachMethod(r, data, i, elem) virtual __UCMethod(elem);
+#define __UCTypedParamsAreEmpty(params) BOOST_PP_IS_EMPTY(BOOST_PP_TUPLE_ELEM(0, params))
+#define __UCTypedArity(params) BOOST_PP_IF(__UCTypedParamsAreEmpty(params), 0, BOOST_PP_TUPLE_SIZE(params))
+#define __UCTypedParamsOf(params) __UCMethodParams(BOOST_PP_TUPLE_TO_LIST(params))
+#define __UCTypedParams(params) BOOST_PP_IIF(__UCTypedParamsAreEmpty(params), __UCNothing, __UCTypedParamsOf)(params)
+#define __UCTypedMethodDecl(name, params, RetType) auto name(__UCTypedParams(params)) -> RetType
+#define __UCWriteEachUntypedMethod(elem) virtual __UCMethod(elem);
+#define __UCWriteEachTypedMethod(elem) virtual __UCTypedMethodDecl elem;
+#define __UCWriteEachMethod(r, data, i, elem) \
+BOOST_PP_IIF(BOOST_PP_EQUAL(BOOST_PP_TUPLE_SIZE(elem), 3), __UCWriteEachTypedMethod, __UCWriteEachUntypedMethod)(elem)
 #define __UCWriteMethodCondsMethParamsHelper(z, i, data) BOOST_PP_COMMA_IF(i) args[i]
 #define __UCWriteMethodCondsMethParams(sz) BOOST_PP_REPEAT(sz, __UCWriteMethodCondsMethParamsHelper, _)
-#define __UCWriteMethodCondsMulti(name, params, ...) \
-if(fname == __ToString(name) && argsLen == BOOST_PP_VARIADIC_SIZE params){\
-	return this->name(__UCWriteMethodCondsMethParams(BOOST_PP_TUPLE_SIZE(params)));\
-}
-#define __UCWriteMethodCondsNo(name, ...) \
-if(fname == __ToString(name) && argsLen == 0){ return this->name(); }
-#define __UCWriteMethodConds(r, data, i, elem)\
-BOOST_PP_IIF(\
+#define __UCWriteMethodEntryMulti(name, params, ...) \
+::UC::_Detail::MethodEntry( __ToString(name), BOOST_PP_VARIADIC_SIZE params, [](::UC::Object& me, ::UC::ArgSpan args) -> ::UC::P<::UC::Object>{\
+	return static_cast<self&>(me).name(__UCWriteMethodCondsMethParams(BOOST_PP_TUPLE_SIZE(params)));\
+} )
+#define __UCWriteMethodEntryNo(name, ...) \
+::UC::_Detail::MethodEntry( __ToString(name), 0, [](::UC::Object& me, ::UC::ArgSpan) -> ::UC::P<::UC::Object>{ return static_cast<self&>(me).name(); } )
+#define __UCWriteMethodEntryTyped(name, params, RetType) \
+::UC::_Detail::MethodEntry( __ToString(name), __UCTypedArity(params), [](::UC::Object& me, [[maybe_unused]] ::UC::ArgSpan args) -> ::UC::P<::UC::Object>{\
+	return ::UC::_Detail::Box(static_cast<self&>(me).name(__UCWriteMethodCondsMethParams(__UCTypedArity(params))));\
+}, [](::UC::Object& me, [[maybe_unused]] ::UC::ArgSpan args, void* result){\
+	*static_cast<RetType*>(result) = static_cast<self&>(me).name(__UCWriteMethodCondsMethParams(__UCTypedArity(params)));\
+}, ::UC::_Detail::ReturnTag<RetType>( ) )
+#define __UCWriteMethodEntry(r, data, i, elem)\
+BOOST_PP_COMMA_IF(i) BOOST_PP_IIF(\
 	BOOST_PP_EQUAL(BOOST_PP_TUPLE_SIZE(elem), 1),\
-	__UCWriteMethodCondsNo, \
-	__UCWriteMethodCondsMulti)elem
+	__UCWriteMethodEntryNo, \
+	BOOST_PP_IIF(BOOST_PP_EQUAL(BOOST_PP_TUPLE_SIZE(elem), 3),\
+		__UCWriteMethodEntryTyped, \
+		__UCWriteMethodEntryMulti))elem
 #define __UCWriteMethods(methSeq) \
 public:\
 BOOST_PP_SEQ_FOR_EACH_I(__UCWriteEachMethod, _, methSeq)\
 protected: \
-auto callImpl( const ::UC::NatString& fname, const ::UC::NatOVector& args ) -> ::UC::P<Object>{\
-	const auto& argsLen = args.size();\
-	BOOST_PP_SEQ_FOR_EACH_I(__UCWriteMethodConds, _, methSeq)\
-	return callImplUpChain(fname, args);\
+static const ::UC::_Detail::MethodTable& __methodTable( ){\
+	static const ::UC::_Detail::MethodTable table{ BOOST_PP_SEQ_FOR_EACH_I(__UCWriteMethodEntry, _, methSeq) };\
+	return table;\
 }\
-public:\
-virtual ::UC::P<Object> Call( const ::UC::NatString& fname, const ::UC::NatOVector& args ) override{return callImpl(fname, args);}
+static auto resolveImpl( const ::UC::_Detail::MethodRef& fname, size_t argsLen ) -> const ::UC::_Detail::MethodEntry*{\
+	if( auto method = __methodTable( ).Find( fname, argsLen ) ) return method;\
+	return resolveImplUpChain(fname, argsLen);\
+}\
+virtual const ::UC::_Detail::MethodEntry* resolveDispatch( const ::UC::_Detail::MethodRef& fname, size_t argsLen ) const override{return resolveImpl(fname, argsLen);}\
+public:
 
 //#define UCInterface __RealInterface
 // , Name ,
@@ -59,28 +78,29 @@ virtual ::UC::P<Object> Call( const ::UC::NatString& fname, const ::UC::NatOVect
 #define __UCWriteEachMaker(r, data, i, elem) data(__UCMethodParams(BOOST_PP_TUPLE_TO_LIST(elem)));
 #define __UCWriteMakerConds(r, data, i, params) \
 case BOOST_PP_VARIADIC_SIZE params:\
-	return ::UC::P<self>(new self(__UCWriteMethodCondsMethParams(BOOST_PP_TUPLE_SIZE(params))));
+	return ::UC::_Detail::MakeGC<self>(__UCWriteMethodCondsMethParams(BOOST_PP_TUPLE_SIZE(params)));
 #define __UCHasExplicitMakers_Decls(name, hasEmptyMaker, seq)\
 protected:\
 BOOST_PP_EXPR_IF(hasEmptyMaker, name();)\
 BOOST_PP_SEQ_FOR_EACH_I(__UCWriteEachMaker, name, seq)
 #define __UCHasExplicitMakers(name, hasEmptyMaker, seq) \
 template<typename... Args>\
-static ::UC::P<self> Make(Args&&... args){return ::UC::P<self>(new self(std::forward<Args>(args)...));}\
+static ::UC::NotNull<::UC::P<self>> Make(Args&&... args){return ::UC::_Detail::MakeGC<self>(std::forward<Args>(args)...);}\
+__UCDefineMakeWith \
 protected:\
 __UCHasExplicitMakers_Decls(name, hasEmptyMaker, seq)\
 public:\
-static ::UC::P<Object> make_reflective( const ::UC::NatOVector& args ){\
+static ::UC::P<Object> make_reflective( ::UC::ArgSpan args ){\
 	switch (args.size()){\
-		BOOST_PP_EXPR_IF(hasEmptyMaker, case 0:return ::UC::P<self>(new self());)\
+		BOOST_PP_EXPR_IF(hasEmptyMaker, case 0:return ::UC::_Detail::MakeGC<self>();)\
 		BOOST_PP_SEQ_FOR_EACH_I(__UCWriteMakerConds, _, seq)\
 		default: throw ::UC::NoSuchConstructor_Exception(::UC::ConcatNatStrings(::UC::NatString("No constructor for type \""),SGetTypeName(),"\" that takes in ", std::to_string(args.size()), " parameters."));\
 	}\
 }
 
 #   define UC_IsSingleton \
-static pself Make(){\
-	static pself v(new self());\
+static ::UC::NotNull<pself> Make(){\
+	static const ::UC::NotNull<pself> v = ::UC::_Detail::MakeGC<self>();\
 	return v;\
 }\
 forceinline static pself GetI(){return Make();}\
@@ -88,34 +108,39 @@ forceinline static pself GetInst(){return Make();}\
 forceinline static pself GetInstance(){return Make();}\
 forceinline static pself Inst(){return Make();}\
 forceinline static pself Instance(){return Make();}\
-static ::UC::P<Object> make_reflective(const ::UC::NatOVector& args){\
+static ::UC::P<Object> make_reflective(::UC::ArgSpan args){\
 	if(args.size() == 0)return Make();\
 	throw ::UC::NoSuchConstructor_Exception(::UC::ConcatNatStrings(::UC::NatString("Type \""),SGetTypeName(),"\" is a singleton and hence the constructor can take only 1 parameter."));\
 }
-#   define UC_IsAbstract static ::UC::P<Object> make_reflective(const ::UC::NatOVector& args){\
+// Makes the Make functions of the UCInterface allocate from the per-thread object pools, it isn't inherited.
+#   define UC_IsPooled using __UCPooledSelf = self
+#   define UC_IsAbstract static ::UC::P<Object> make_reflective(::UC::ArgSpan args){\
 	throw ::UC::NoSuchConstructor_Exception(SGetTypeName() + " is an abstract class that can't be instantiated.");\
 }
-#   define UC_IsAbstractAndHasCtors(name, hasEmptyCtor,...) protected: __UCHasExplicitMakers_Decls(name, hasEmptyCtor, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__)) public: static ::UC::P<Object> make_reflective(const ::UC::NatOVector& args){\
+#   define UC_IsAbstractAndHasCtors(name, hasEmptyCtor,...) protected: __UCHasExplicitMakers_Decls(name, hasEmptyCtor, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__)) public: static ::UC::P<Object> make_reflective(::UC::ArgSpan args){\
 	throw ::UC::NoSuchConstructor_Exception(SGetTypeName() + " is an abstract class that can't be instantiated.");\
 }
-#   define UC_OnlyHasNativeCtors static ::UC::P<Object> make_reflective(const ::UC::NatOVector& args){\
+#   define UC_OnlyHasNativeCtors static ::UC::P<Object> make_reflective(::UC::ArgSpan args){\
 	throw ::UC::NoSuchConstructor_Exception(SGetTypeName() + " can't be instantiated by reflection.");\
 }\
 template<typename... Args>\
-static ::UC::P<self> Make(Args&&... args){return ::UC::P<self>(new self(std::forward<Args>(args)...));}\
+static ::UC::NotNull<::UC::P<self>> Make(Args&&... args){return ::UC::_Detail::MakeGC<self>(std::forward<Args>(args)...);}\
+__UCDefineMakeWith \
 	// or
 #   define UC_OnlyHasEmptyCtor \
-static ::UC::P<self> Make(){return ::UC::P<self>(new self());}\
-static ::UC::P<Object> make_reflective(const ::UC::NatOVector& args){\
-	if(args.size() == 0)return ::UC::P<Object>(new self());\
+static ::UC::NotNull<::UC::P<self>> Make(){return ::UC::_Detail::MakeGC<self>();}\
+__UCDefineMakeWith \
+static ::UC::P<Object> make_reflective(::UC::ArgSpan args){\
+	if(args.size() == 0)return Make();\
 	throw ::UC::NoSuchConstructor_Exception(::UC::ConcatNatStrings(::UC::NatString("No constructor for type \""),SGetTypeName(),"\" that takes in ", std::to_string(args.size()), " parameters."));\
 }
 	// or
 #   define UC_HasNativeCtorsAndEmptyCtor \
 template<typename... Args>\
-static ::UC::P<self> Make(Args&&... args){return ::UC::P<self>(new self(std::forward<Args>(args)...));}\
-static ::UC::P<Object> make_reflective(const ::UC::NatOVector& args){\
-	if(args.size() == 0)return ::UC::P<Object>(new self());\
+static ::UC::NotNull<::UC::P<self>> Make(Args&&... args){return ::UC::_Detail::MakeGC<self>(std::forward<Args>(args)...);}\
+__UCDefineMakeWith \
+static ::UC::P<Object> make_reflective(::UC::ArgSpan args){\
+	if(args.size() == 0)return Make();\
 	throw ::UC::NoSuchConstructor_Exception(::UC::ConcatNatStrings(::UC::NatString("No constructor for type \""),SGetTypeName(),"\" that takes in ", std::to_string(args.size()), " parameters."));\
 }
 	// or
@@ -129,11 +154,11 @@ static ::UC::P<Object> make_reflective(const ::UC::NatOVector& args){\
 #define UC_HasMethods(...) __UCWriteMethods(BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
 #define UC_HasNoMethods \
 protected: \
-forceinline auto callImpl( const ::UC::NatString& fname, const ::UC::NatOVector& args ) -> ::UC::P<Object>{\
-	return callImplUpChain(fname, args);\
+forceinline static auto resolveImpl( const ::UC::_Detail::MethodRef& fname, size_t argsLen ) -> const ::UC::_Detail::MethodEntry*{\
+	return resolveImplUpChain(fname, argsLen);\
 }\
-public:\
-virtual ::UC::P<Object> Call( const ::UC::NatString& fname, const ::UC::NatOVector& args ) override{return callImpl(fname, args);}
+virtual const ::UC::_Detail::MethodEntry* resolveDispatch( const ::UC::_Detail::MethodRef& fname, size_t argsLen ) const override{return resolveImpl(fname, argsLen);}\
+public:
 // ,
 
 #define __UCExpandInheritanceHelper(r, data, i, elem) using BOOST_PP_CAT(base, i) = elem;
@@ -141,23 +166,69 @@ virtual ::UC::P<Object> Call( const ::UC::NatString& fname, const ::UC::NatOVect
 #define __UCExpandInheritanceInBracesHelper(r, data, i, elem) using BOOST_PP_CAT(base, i) = __UCEXP elem;
 #define __UCExpandInheritanceAsUsingsUC_InheritsUCClassesInBraces(...) BOOST_PP_SEQ_FOR_EACH_I(__UCExpandInheritanceInBracesHelper, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
 #define __UCExpandInheritanceUC_InheritsUCClasses(...) __VA_ARGS__
-#define __UCDefine_callUpChainWithInheritsHelperH(baseN, resN) \
-try{\
-	auto resN = baseN::callImpl(fname, args);\
-	if(resN) return resN;\
-}\
-catch(const ::UC::NoSuchFunction_Exception&){}
-#define __UCDefine_callUpChainWithInheritsHelper(r, data, i, elem) \
-__UCDefine_callUpChainWithInheritsHelperH(BOOST_PP_CAT(base, i), BOOST_PP_CAT(res, i))
-#define __UCDefine_callUpChainWithUC_InheritsUCClasses(...) BOOST_PP_SEQ_FOR_EACH_I(__UCDefine_callUpChainWithInheritsHelper, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+#define __UCDefine_resolveUpChainWithInheritsHelperH(baseN, resN) \
+if( auto resN = baseN::resolveImpl(fname, argsLen) ) return resN;
+#define __UCDefine_resolveUpChainWithInheritsHelper(r, data, i, elem) \
+__UCDefine_resolveUpChainWithInheritsHelperH(BOOST_PP_CAT(base, i), BOOST_PP_CAT(res, i))
+#define __UCDefine_resolveUpChainWithUC_InheritsUCClasses(...) BOOST_PP_SEQ_FOR_EACH_I(__UCDefine_resolveUpChainWithInheritsHelper, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+#define __UCDefine_typeInfoBasesWithInheritsHelper(r, data, i, elem) BOOST_PP_COMMA_IF(i) &BOOST_PP_CAT(base, i)::SGetTypeInfo( )
+#define __UCDefine_typeInfoBasesWithUC_InheritsUCClasses(...) BOOST_PP_SEQ_FOR_EACH_I(__UCDefine_typeInfoBasesWithInheritsHelper, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+#define __UCDefine_traceBasesWithInheritsHelper(r, data, i, elem) BOOST_PP_CAT(base, i)::TraceEdges( __visitor );
+#define __UCDefine_traceBasesWithUC_InheritsUCClasses(...) BOOST_PP_SEQ_FOR_EACH_I(__UCDefine_traceBasesWithInheritsHelper, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+#define __UCDefine_clearBasesWithInheritsHelper(r, data, i, elem) BOOST_PP_CAT(base, i)::ClearEdges( );
+#define __UCDefine_clearBasesWithUC_InheritsUCClasses(...) BOOST_PP_SEQ_FOR_EACH_I(__UCDefine_clearBasesWithInheritsHelper, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+#define __UCDefine_basesHaveEdgesWithInheritsHelper(r, data, i, elem) || ::UC::_Detail::GCAccess::IsTraced<BOOST_PP_CAT(base, i)>( )
+#define __UCDefine_basesHaveEdgesWithUC_InheritsUCClasses(...) BOOST_PP_SEQ_FOR_EACH_I(__UCDefine_basesHaveEdgesWithInheritsHelper, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
+#define __UCDefineTypeInfo(Inheritance) \
+	static const ::UC::TypeInfo& SGetTypeInfo( ){\
+		static const ::UC::TypeInfo info( SGetTypeName( ), { __UCDefine_typeInfoBasesWith##Inheritance } );\
+		return info;\
+	}\
+	/*Inherited via ::UC::Object*/\
+	virtual const ::UC::TypeInfo& GetTypeInfo( ) const override{\
+		return SGetTypeInfo( );\
+	}\
+	/*Used by UC_HasGCEdges*/\
+	static constexpr bool __UCBasesHaveGCEdges( ){ return false __UCDefine_basesHaveEdgesWith##Inheritance; }\
+	forceinline void __UCTraceBaseEdges( ::UC::GC::EdgeVisitor& __visitor ) const{ __UCDefine_traceBasesWith##Inheritance }\
+	forceinline void __UCClearBaseEdges( ){ __UCDefine_clearBasesWith##Inheritance }
+
+#define __UCTraceEdgeHelper(r, data, elem) __visitor( elem );
+#define __UCClearEdgeHelper(r, data, elem) ::UC::GC::ClearEdge( elem );
+#define __UCHasEdgeHelper(r, data, elem) || ::UC::_Detail::HoldsGCEdges<decltype( elem )>( )
+// Declares the fields of the UCInterface that hold P<T>s (directly, in pairs or in containers) as its outgoing edges for the cycle collector, see UC::GC::Collect.
+// The edges of the inherited UC++ Interfaces are traced as well, fields that aren't listed and captures of lambdas aren't.
+#define UC_HasGCEdges(...) \
+public:\
+	/*Objects are only tracked by the cycle collector if at least one of the fields can hold a P<T> to a UCInterface.*/\
+	static constexpr bool __UCHasGCEdges( ){ return __UCBasesHaveGCEdges( ) BOOST_PP_SEQ_FOR_EACH(__UCHasEdgeHelper, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__)); }\
+	/*Inherited via ::UC::Object*/\
+	virtual void TraceEdges( ::UC::GC::EdgeVisitor& __visitor ) const override{\
+		__UCTraceBaseEdges( __visitor );\
+		BOOST_PP_SEQ_FOR_EACH(__UCTraceEdgeHelper, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))\
+	}\
+	/*Inherited via ::UC::Object*/\
+	virtual void ClearEdges( ) override{\
+		__UCClearBaseEdges( );\
+		BOOST_PP_SEQ_FOR_EACH(__UCClearEdgeHelper, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))\
+	}
+
+// Lets the factories construct the UCInterface through its protected constructors.
+#define __UCBefriendGCAccess friend struct ::UC::_Detail::GCAccess;
+
+// Make, but the object & its reference counts are allocated together with alloc.
+#define __UCDefineMakeWith \
+template<typename TAlloc, typename... Args>\
+static ::UC::NotNull<::UC::P<self>> MakeWith(const TAlloc& alloc, Args&&... args){return ::UC::_Detail::AllocateGC<self>(alloc, std::forward<Args>(args)...);}
 
 #define __UCDefineClassRegistererAndTypename(str, Inheritance) \
 protected:\
-	auto callImplUpChain(const ::UC::NatString& fname, const ::UC::NatOVector& args) -> ::UC::P<Object>{__UCDefine_callUpChainWith##Inheritance; throw ::UC::NoSuchFunction_Exception(::UC::ConcatNatStrings(::UC::NatString("No function for type \"" str "\" with name \""), fname, "\" that takes in ", std::to_string(args.size()), " parameters."));}\
+	static auto resolveImplUpChain(const ::UC::_Detail::MethodRef& fname, size_t argsLen) -> const ::UC::_Detail::MethodEntry*{__UCDefine_resolveUpChainWith##Inheritance; return nullptr;}\
 private:\
 	struct __classRegisterer{\
 		__classRegisterer(){\
 			::UC::Object::addConstructor(str, &self::make_reflective);\
+			self::SGetTypeInfo( );\
 		}\
 	};\
 	static __classRegisterer __classRegistererInstance;\
@@ -169,7 +240,9 @@ public:\
 	/*Inherited via ::UC::Object*/\
 	virtual const ::UC::NatString& GetTypeName( ) const override{\
 		return SGetTypeName( );\
-	}
+	}\
+	__UCDefineTypeInfo(Inheritance)\
+	__UCBefriendGCAccess
 
 #define __UCExpandUC_InheritsUCClassesInBracesHelper(r, data, i, elem) BOOST_PP_COMMA_IF(i) __UCEXP elem
 #define __UCExpandUC_InheritsUCClassesInBraces(...) BOOST_PP_SEQ_FOR_EACH_I(__UCExpandUC_InheritsUCClassesInBracesHelper, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))
@@ -203,16 +276,34 @@ struct Name __VA_ARGS__ : __UCExpand##Inheritance __UCExpand##NativeInheritance,
 
 #define UCEndInterface };
 
+// The per-type stack trace setting of a UCException, see UC::StackTraceMode.
+#define __UCExceptionStackTraces(Name) \
+/*Overrides UC::Exception::SetStackTraceMode for this exception type & the ones based on it, StackTraceMode::Inherit removes the override.*/\
+static void SetStackTraceMode(::UC::StackTraceMode mode, uint32_t sampleEvery = 1)noexcept{__UCStackTracePolicy().Set(mode, sampleEvery);}\
+static ::UC::StackTraceMode GetStackTraceMode()noexcept{return __UCStackTracePolicy().Mode();}\
+protected:\
+Name(::UC::NatString&& str, ::UC::StackTraceMode mode)noexcept:base(::std::move(str), mode){}\
+static ::UC::StackTracePolicy& __UCStackTracePolicy()noexcept{\
+	static ::UC::StackTracePolicy policy(::UC::StackTraceMode::Inherit);\
+	return policy;\
+}\
+static ::UC::StackTraceMode __UCNextStackTraceMode()noexcept{\
+	auto mode = __UCStackTracePolicy().Next();\
+	return mode == ::UC::StackTraceMode::Inherit ? base::__UCNextStackTraceMode() : mode;\
+}
+
 #define UCException(Name) struct Name: public ::UC::Exception{\
 using base = ::UC::Exception;\
-Name(::UC::NatString&& str)noexcept:base(str){}\
-Name(const ::UC::NatString& str)noexcept:base(str){}\
+Name(::UC::NatString&& str)noexcept:base(::std::move(str), __UCNextStackTraceMode()){}\
+Name(const ::UC::NatString& str)noexcept:base(::UC::NatString(str), __UCNextStackTraceMode()){}\
+__UCExceptionStackTraces(Name)\
 };
 
 #define UCBasedException(Name, Base) struct Name: public Base{\
 using base = Base;\
-Name(::UC::NatString&& str)noexcept:base(str){}\
-Name(const ::UC::NatString& str)noexcept:base(str){}\
+Name(::UC::NatString&& str)noexcept:base(::std::move(str), __UCNextStackTraceMode()){}\
+Name(const ::UC::NatString& str)noexcept:base(::UC::NatString(str), __UCNextStackTraceMode()){}\
+__UCExceptionStackTraces(Name)\
 };
 
 #define ME EGCPFM::GCFromMe()
@@ -222,6 +313,8 @@ Name(const ::UC::NatString& str)noexcept:base(str){}\
 #define __UCMTPMethod(tuple) BOOST_PP_TUPLE_ELEM(0, tuple) (__UCGetGetMethodParamsIfExists(tuple)) -> ::UC::P<Object>
 
 #define UCMethod(...) __UCMethod((__VA_ARGS__))
+#define __UCTypedMethod(RetType, tuple) auto BOOST_PP_TUPLE_ELEM(0, tuple) (__UCGetGetMethodParamsIfExists(tuple)) -> RetType
+#define UCTypedMethod(RetType, ...) __UCTypedMethod(RetType, (__VA_ARGS__))
 #define __UCEXP(...) __VA_ARGS__
 #define UC_MTPMethod(ClsT,...) auto __UCEXP ClsT::__UCMTPMethod((__VA_ARGS__))
 
@@ -257,7 +350,7 @@ Name(const ::UC::NatString& str)noexcept:base(str){}\
 
 #define __UCDefineTemplateTypename(str, Inheritance, TypeParams) \
 protected:\
-	auto callImplUpChain(const ::UC::NatString& fname, const ::UC::NatOVector& args) -> ::UC::P<Object>{__UCDefine_callUpChainWith##Inheritance; throw ::UC::NoSuchFunction_Exception(::UC::ConcatNatStrings(::UC::NatString("No function for type \""), SGetTypeName(), "\" with name \"", fname, "\" that takes in ", std::to_string(args.size()), " parameters."));}\
+	static auto resolveImplUpChain(const ::UC::_Detail::MethodRef& fname, size_t argsLen) -> const ::UC::_Detail::MethodEntry*{__UCDefine_resolveUpChainWith##Inheritance; return nullptr;}\
 public:\
 	static const ::UC::NatString& SGetSimpleTypeName( ){\
 		static auto nm = ::UC::NatString( str );\
@@ -270,7 +363,9 @@ public:\
 	/*Inherited via ::UC::Object*/\
 	virtual const ::UC::NatString& GetTypeName( ) const override{\
 		return SGetTypeName( );\
-	}
+	}\
+	__UCDefineTypeInfo(Inheritance)\
+	__UCBefriendGCAccess
 
 #define __UCExpandAsOnlyObjectHelper(r, data, i, elem) BOOST_PP_COMMA_IF(i) ::UC::Object
 #define __UCExpandAsOnlyObject(tup) BOOST_PP_SEQ_FOR_EACH_I(__UCExpandAsOnlyObjectHelper, _, BOOST_PP_TUPLE_TO_SEQ(tup))
@@ -295,7 +390,7 @@ __UCExpandAsTemplate(TypeParams) struct Name : __UCExpand##Inheritance __UCExpan
 
 #define __UCDefineTemplateTypenameWithPack(str, Inheritance, TypeParams, PackParam) \
 protected:\
-	auto callImplUpChain(const ::UC::NatString& fname, const ::UC::NatOVector& args) -> ::UC::P<Object>{__UCDefine_callUpChainWith##Inheritance; throw ::UC::NoSuchFunction_Exception(::UC::ConcatNatStrings(::UC::NatString("No function for type \""), SGetTypeName(), "\" with name \"", fname, "\" that takes in ", std::to_string(args.size()), " parameters."));}\
+	static auto resolveImplUpChain(const ::UC::_Detail::MethodRef& fname, size_t argsLen) -> const ::UC::_Detail::MethodEntry*{__UCDefine_resolveUpChainWith##Inheritance; return nullptr;}\
 public:\
 	static const ::UC::NatString& SGetSimpleTypeName( ){\
 		static auto nm = ::UC::NatString( str );\
@@ -308,7 +403,9 @@ public:\
 	/*Inherited via ::UC::Object*/\
 	virtual const ::UC::NatString& GetTypeName( ) const override{\
 		return SGetTypeName( );\
-	}
+	}\
+	__UCDefineTypeInfo(Inheritance)\
+	__UCBefriendGCAccess
 
 #define __UCExpandAsTemplateParamPack(tup, PackParamName) template<BOOST_PP_SEQ_FOR_EACH_I(__UCExpandUCTemplateHelper, _, BOOST_PP_TUPLE_TO_SEQ(tup)), typename... PackParamName>
 
@@ -332,7 +429,7 @@ __UCExpandAsTemplateParamPack(TypeParams, PackParamName) struct Name __VA_ARGS__
 
 #define __UCDefineTemplateTypenameWithOnlyPack(str, Inheritance, PackParam) \
 protected:\
-	auto callImplUpChain(const ::UC::NatString& fname, const ::UC::NatOVector& args) -> ::UC::P<Object>{__UCDefine_callUpChainWith##Inheritance; throw ::UC::NoSuchFunction_Exception(::UC::ConcatNatStrings(::UC::NatString("No function for type \""), SGetTypeName(), "\" with name \"", fname, "\" that takes in ", std::to_string(args.size()), " parameters."));}\
+	static auto resolveImplUpChain(const ::UC::_Detail::MethodRef& fname, size_t argsLen) -> const ::UC::_Detail::MethodEntry*{__UCDefine_resolveUpChainWith##Inheritance; return nullptr;}\
 public:\
 	static const ::UC::NatString& SGetSimpleTypeName( ){\
 		static auto nm = ::UC::NatString( str );\
@@ -345,7 +442,9 @@ public:\
 	/*Inherited via ::UC::Object*/\
 	virtual const ::UC::NatString& GetTypeName( ) const override{\
 		return SGetTypeName( );\
-	}
+	}\
+	__UCDefineTypeInfo(Inheritance)\
+	__UCBefriendGCAccess
 
 /// <summary>
 /// This macro defines a template interface that has a template parameter pack. The template interface defined inherits UC::Object, it simplifies much of the boiler plate code.
@@ -365,7 +464,11 @@ template<typename... PackParam> struct Name __VA_ARGS__ :  __UCExpand##Inheritan
 		/*else*/\
 			BOOST_PP_SEQ_ELEM(1, StrName) ), UC_InheritsUCClasses( Inheritance ), PackParam )
 
-#define UCC(var, fname, ...) var->Call(fname, __VA_ARGS__)
+#define UCCallSiteCache() ([]( ) -> ::UC::CallSiteCache& { static thread_local ::UC::CallSiteCache __cache; return __cache; }( ))
+#define UCC(var, fname, ...) UCCallSiteCache().Call(var, fname, __VA_ARGS__)
+
+#define UCSelector(fname) ([]( ) -> ::UC::Selector { static const ::UC::Selector __sel = ::UC::Selector::Intern( fname ); return __sel; }( ))
+#define UCCS(var, fname, ...) UCCallSiteCache().Call(var, UCSelector(fname), __VA_ARGS__)
 
 #define UCRegisterTemplate(name, ...) struct __##name##_class_registerer_class{\
 	__##name##_class_registerer_class(){::UC::Object::addConstructor(name __VA_ARGS__::SGetSimpleTypeName(), &(name __VA_ARGS__::make_reflective));}\
@@ -1,22 +1,536 @@
 #include "stdafx.h"
 #include "Object.hpp"
+#include <unordered_set>
+#include <sstream>
+#include <array>
+#include <bitset>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define __UC_SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVC allows the AVX2 intrinsics in any function.
+#define __UC_TARGET_AVX2
+#else
+#define __UC_TARGET_AVX2 __attribute__( ( target( "avx2" ) ) )
+#endif
+#endif
 
 namespace UC
 {
-	std::unordered_map<NatString , Object::CtorT>& getClassCtors( )
+	struct ClassRegistry
+	{
+		struct Entry
+		{
+			const NatString* name;
+			Object::CtorT ctor;
+		};
+		// Keyed on views of the names in "names", so that lookups by std::string_view don't allocate.
+		// std::deque never relocates its elements, so the views stay valid.
+		std::unordered_map<std::string_view , Entry> ctors;
+		std::deque<NatString> names;
+	};
+	ClassRegistry& getClassRegistry( )
+	{
+		static ClassRegistry registry {};
+		return registry;
+	}
+	struct SelectorTable
+	{
+		boost::shared_mutex mtx;
+		std::unordered_map<std::string_view , const _Detail::SelectorInfo*> ids;
+		std::deque<_Detail::SelectorInfo> infos;
+	};
+	SelectorTable& getSelectorTable( )
+	{
+		static SelectorTable table {};
+		return table;
+	}
+	Selector Selector::Intern( std::string_view name )
+	{
+		decltype( auto ) table = getSelectorTable( );
+		{
+			boost::shared_lock<boost::shared_mutex> __lock( table.mtx );
+			auto itr = table.ids.find( name );
+			if ( itr != table.ids.end( ) ) return Selector( itr->second );
+		}
+		boost::unique_lock<boost::shared_mutex> __lock( table.mtx );
+		auto itr = table.ids.find( name );
+		if ( itr != table.ids.end( ) ) return Selector( itr->second );
+		// std::deque never relocates its elements, so the view of the name & the pointers handed out stay valid.
+		auto& info = table.infos.emplace_back( _Detail::SelectorInfo {
+			NatString( name ) , _Detail::HashMethodName( name.data( ) , name.size( ) ) , static_cast< id_t >( table.infos.size( ) ) } );
+		table.ids.emplace( std::string_view( info.name ) , &info );
+		return Selector( &info );
+	}
+	std::optional<Selector> Selector::Find( std::string_view name )
+	{
+		decltype( auto ) table = getSelectorTable( );
+		boost::shared_lock<boost::shared_mutex> __lock( table.mtx );
+		auto itr = table.ids.find( name );
+		if ( itr == table.ids.end( ) ) return std::nullopt;
+		return Selector( itr->second );
+	}
+	size_t Selector::Count( )
+	{
+		decltype( auto ) table = getSelectorTable( );
+		boost::shared_lock<boost::shared_mutex> __lock( table.mtx );
+		return table.infos.size( );
+	}
+
+	struct PoolRegistry
+	{
+		boost::mutex mtx;
+		std::vector<_Detail::ThreadPools*> live;
+		// The statistics of the threads that have exited.
+		PoolStats retired;
+		// The hits & misses at the last ObjectPools::ResetStats.
+		PoolStats baseline;
+	};
+	PoolRegistry& getPoolRegistry( )
+	{
+		static PoolRegistry registry {};
+		return registry;
+	}
+	_Detail::ThreadPools::ThreadPools( )
+	{
+		decltype( auto ) registry = getPoolRegistry( );
+		boost::lock_guard<boost::mutex> __lock( registry.mtx );
+		registry.live.push_back( this );
+	}
+	_Detail::ThreadPools::~ThreadPools( )
+	{
+		Trim( );
+		current = nullptr;
+		finished = true;
+		decltype( auto ) registry = getPoolRegistry( );
+		boost::lock_guard<boost::mutex> __lock( registry.mtx );
+		registry.live.erase( std::find( registry.live.begin( ) , registry.live.end( ) , this ) );
+		registry.retired.Hits += hits.load( std::memory_order_relaxed );
+		registry.retired.Misses += misses.load( std::memory_order_relaxed );
+	}
+	_Detail::ThreadPools* _Detail::ThreadPools::create( )
+	{
+		static thread_local ThreadPools pools;
+		return current = &pools;
+	}
+	void _Detail::ThreadPools::Trim( ) noexcept
+	{
+		for ( auto& list : lists )
+		{
+			while ( list.head != nullptr )
+			{
+				FreeBlock* block = list.head;
+				list.head = block->next;
+				::operator delete( block );
+			}
+			list.count = 0;
+		}
+		residentBlocks.store( 0 , std::memory_order_relaxed );
+		residentBytes.store( 0 , std::memory_order_relaxed );
+	}
+	PoolStats _Detail::ThreadPools::GetStats( ) const noexcept
+	{
+		PoolStats stats;
+		stats.Hits = hits.load( std::memory_order_relaxed );
+		stats.Misses = misses.load( std::memory_order_relaxed );
+		stats.ResidentBlocks = residentBlocks.load( std::memory_order_relaxed );
+		stats.ResidentBytes = residentBytes.load( std::memory_order_relaxed );
+		return stats;
+	}
+	PoolStats ObjectPools::GetStats( )
+	{
+		decltype( auto ) registry = getPoolRegistry( );
+		boost::lock_guard<boost::mutex> __lock( registry.mtx );
+		PoolStats total = registry.retired;
+		for ( auto pools : registry.live )
+		{
+			auto stats = pools->GetStats( );
+			total.Hits += stats.Hits;
+			total.Misses += stats.Misses;
+			total.ResidentBlocks += stats.ResidentBlocks;
+			total.ResidentBytes += stats.ResidentBytes;
+		}
+		total.Hits -= registry.baseline.Hits;
+		total.Misses -= registry.baseline.Misses;
+		return total;
+	}
+	void ObjectPools::ResetStats( )
+	{
+		decltype( auto ) registry = getPoolRegistry( );
+		boost::lock_guard<boost::mutex> __lock( registry.mtx );
+		PoolStats total = registry.retired;
+		for ( auto pools : registry.live )
+		{
+			auto stats = pools->GetStats( );
+			total.Hits += stats.Hits;
+			total.Misses += stats.Misses;
+		}
+		registry.baseline = total;
+	}
+	void ObjectPools::TrimThisThread( )
+	{
+		if ( auto pools = _Detail::ThreadPools::Current( ) ) pools->Trim( );
+	}
+
+	struct CycleRegistry
+	{
+		boost::mutex mtx;
+		std::vector<WeakPtr<Object>> candidates;
+		// The candidate GC::CollectFor continues from.
+		size_t cursor = 0;
+		// The objects GC::CollectFor found alive since the cursor last wrapped, their closures have no garbage, so they aren't examined again.
+		// An object freed since may have its address reused, the new object is then only examined in the next pass over the candidates.
+		std::unordered_set<const Object*> alive;
+		// The expired candidates are removed when there are this many candidates.
+		size_t pruneAt = 64;
+
+		// Removes the expired candidates, mtx must be locked.
+		void Prune( )
+		{
+			size_t kept = 0 , newCursor = 0;
+			for ( size_t i = 0; i < candidates.size( ); i++ )
+			{
+				if ( i == cursor ) newCursor = kept;
+				if ( candidates[ i ].Expired( ) ) continue;
+				if ( kept != i ) candidates[ kept ] = std::move( candidates[ i ] );
+				kept++;
+			}
+			cursor = cursor < candidates.size( ) ? newCursor : kept;
+			candidates.erase( candidates.begin( ) + kept , candidates.end( ) );
+			pruneAt = std::max<size_t>( 64 , kept * 2 );
+		}
+	};
+	CycleRegistry& getCycleRegistry( )
+	{
+		static CycleRegistry registry {};
+		return registry;
+	}
+	void _Detail::TrackCycleCandidate( const GCPtr<Object>& obj )
+	{
+		decltype( auto ) registry = getCycleRegistry( );
+		boost::lock_guard<boost::mutex> __lock( registry.mtx );
+		registry.candidates.emplace_back( obj );
+		if ( registry.candidates.size( ) >= registry.pruneAt ) registry.Prune( );
+	}
+
+	// Trial deletion over the closure of the starting objects:
+	// every reference to an object that doesn't come from an edge inside the closure is external,
+	// the objects reachable from the externally referenced ones are alive & the rest are garbage cycles.
+	class CycleTrial : public GC::EdgeVisitor
+	{
+		struct Node
+		{
+			P<Object> hold;
+			std::vector<size_t> edges;
+			long internalRefs = 0;
+			bool alive = false;
+
+			explicit Node( P<Object>&& hold ) noexcept : hold( std::move( hold ) ) { }
+		};
+		std::vector<Node> nodes;
+		std::unordered_map<const Object*, size_t> indices;
+		size_t current = 0;
+
+		static long useCount( const P<Object>& obj ) noexcept
+		{
+#ifdef UC_INTRUSIVE_GCPTR
+			return static_cast< long >( obj->UseCount( ) );
+#else
+			return obj.ptr.use_count( );
+#endif
+		}
+	public:
+		void Visit( Object* target ) override
+		{
+			auto [itr , inserted] = indices.emplace( target , nodes.size( ) );
+			if ( inserted ) nodes.emplace_back( target->GCFromMe( ) );
+			nodes[ current ].edges.push_back( itr->second );
+			nodes[ itr->second ].internalRefs++;
+		}
+		void AddStart( P<Object>&& obj )
+		{
+			if ( indices.emplace( std::addressof( *obj ) , nodes.size( ) ).second ) nodes.emplace_back( std::move( obj ) );
+		}
+		// Frees the garbage cycles in the closure, the objects found alive are added to alive if it isn't null.
+		GC::CollectStats Run( std::unordered_set<const Object*>* alive = nullptr )
+		{
+			for ( current = 0; current < nodes.size( ); current++ ) nodes[ current ].hold->TraceEdges( *this );
+
+			std::vector<size_t> pending;
+			for ( size_t i = 0; i < nodes.size( ); i++ )
+			{
+				// One of the references is the hold of the trial itself.
+				if ( useCount( nodes[ i ].hold ) - 1 > nodes[ i ].internalRefs )
+				{
+					nodes[ i ].alive = true;
+					pending.push_back( i );
+				}
+			}
+			while ( !pending.empty( ) )
+			{
+				auto i = pending.back( );
+				pending.pop_back( );
+				for ( auto to : nodes[ i ].edges )
+				{
+					if ( nodes[ to ].alive ) continue;
+					nodes[ to ].alive = true;
+					pending.push_back( to );
+				}
+			}
+
+			GC::CollectStats stats;
+			stats.Examined = nodes.size( );
+			std::vector<P<Object>> garbage;
+			for ( auto& node : nodes )
+			{
+				if ( !node.alive ) garbage.push_back( std::move( node.hold ) );
+				else if ( alive != nullptr ) alive->insert( std::addressof( *node.hold ) );
+			}
+			nodes.clear( );
+			indices.clear( );
+			// Breaking the cycles leaves the holds of the trial as the only references, dropping them frees the garbage.
+			for ( auto& obj : garbage ) obj->ClearEdges( );
+			stats.Freed = garbage.size( );
+			return stats;
+		}
+	};
+
+	size_t GC::TrackedCount( )
+	{
+		decltype( auto ) registry = getCycleRegistry( );
+		boost::lock_guard<boost::mutex> __lock( registry.mtx );
+		registry.Prune( );
+		return registry.candidates.size( );
+	}
+	size_t GC::Collect( )
+	{
+		decltype( auto ) registry = getCycleRegistry( );
+		CycleTrial trial;
+		{
+			boost::lock_guard<boost::mutex> __lock( registry.mtx );
+			registry.Prune( );
+			for ( const auto& candidate : registry.candidates )
+				if ( auto obj = candidate.Lock( ) ) trial.AddStart( std::move( obj ) );
+		}
+		return trial.Run( ).Freed;
+	}
+	GC::CollectStats GC::CollectFor( std::chrono::microseconds budget )
+	{
+		const auto deadline = std::chrono::steady_clock::now( ) + budget;
+		decltype( auto ) registry = getCycleRegistry( );
+		CollectStats stats;
+		std::unordered_set<const Object*> alive;
+		do
+		{
+			P<Object> start;
+			{
+				boost::lock_guard<boost::mutex> __lock( registry.mtx );
+				registry.alive.insert( alive.begin( ) , alive.end( ) );
+				alive.clear( );
+				while ( start == nullptr && registry.cursor < registry.candidates.size( ) )
+				{
+					start = registry.candidates[ registry.cursor++ ].Lock( );
+					if ( start != nullptr && registry.alive.count( std::addressof( *start ) ) != 0 ) start.Reset( );
+				}
+				if ( start == nullptr )
+				{
+					registry.cursor = 0;
+					registry.alive.clear( );
+					stats.Finished = true;
+					break;
+				}
+			}
+			CycleTrial trial;
+			trial.AddStart( std::move( start ) );
+			auto result = trial.Run( &alive );
+			stats.Examined += result.Examined;
+			stats.Freed += result.Freed;
+		} while ( std::chrono::steady_clock::now( ) < deadline );
+		if ( !alive.empty( ) )
+		{
+			boost::lock_guard<boost::mutex> __lock( registry.mtx );
+			registry.alive.insert( alive.begin( ) , alive.end( ) );
+		}
+		return stats;
+	}
+
+	std::atomic<TypeInfo::id_t>& getTypeIdCounter( )
+	{
+		static std::atomic<TypeInfo::id_t> counter { 0 };
+		return counter;
+	}
+	TypeInfo::TypeInfo( const NatString& name , std::initializer_list<const TypeInfo*> bases ) :
+		id( getTypeIdCounter( ).fetch_add( 1 ) ) , name( name ) , ancestors( id + 1 )
+	{
+		// The bases are initialized before this type, so their ancestors are all below this type's ID.
+		for ( auto base : bases )
+			for ( auto i = base->ancestors.find_first( ); i != boost::dynamic_bitset<>::npos; i = base->ancestors.find_next( i ) )
+				ancestors.set( i );
+		ancestors.set( id );
+	}
+	size_t TypeInfo::Count( ) noexcept { return getTypeIdCounter( ).load( ); }
+
+	struct TypeCounters
+	{
+		std::atomic<const TypeInfo*> info { nullptr };
+		std::atomic<size_t> objectSize { 0 };
+		std::atomic<int64_t> live { 0 };
+		std::atomic<uint64_t> allocated { 0 };
+	};
+	// The counters are indexed by type ID & allocated a chunk at a time, so they never move & are counted without a lock.
+	// The chunks are never freed, as objects in static storage may be destroyed after this.
+	struct TypeStatsRegistry
+	{
+		static constexpr size_t chunkSize = 256;
+		static constexpr size_t chunkCount = 256;
+		std::array<std::atomic<TypeCounters*> , chunkCount> chunks { };
+
+		TypeCounters* Find( TypeInfo::id_t id ) const noexcept
+		{
+			if ( id / chunkSize >= chunkCount ) return nullptr;
+			auto chunk = chunks[ id / chunkSize ].load( std::memory_order_acquire );
+			return chunk == nullptr ? nullptr : chunk + id % chunkSize;
+		}
+		TypeCounters* Get( TypeInfo::id_t id ) noexcept
+		{
+			if ( id / chunkSize >= chunkCount ) return nullptr;
+			auto& slot = chunks[ id / chunkSize ];
+			auto chunk = slot.load( std::memory_order_acquire );
+			if ( chunk == nullptr )
+			{
+				auto made = new ( std::nothrow ) TypeCounters[ chunkSize ];
+				if ( made == nullptr ) return nullptr;
+				if ( slot.compare_exchange_strong( chunk , made , std::memory_order_acq_rel ) ) chunk = made;
+				else delete[ ] made;
+			}
+			return chunk + id % chunkSize;
+		}
+	};
+	TypeStatsRegistry& getTypeStatsRegistry( )
+	{
+		static TypeStatsRegistry registry {};
+		return registry;
+	}
+
+	void _Detail::CountAllocation( const TypeInfo& type , size_t size ) noexcept
 	{
-		static std::unordered_map<NatString , Object::CtorT> classCtors {};
-		return classCtors;
+		auto counters = getTypeStatsRegistry( ).Get( type.Id( ) );
+		if ( counters == nullptr ) return;
+		counters->info.store( &type , std::memory_order_relaxed );
+		counters->objectSize.store( size , std::memory_order_relaxed );
+		counters->allocated.fetch_add( 1 , std::memory_order_relaxed );
+		counters->live.fetch_add( 1 , std::memory_order_relaxed );
 	}
+	void _Detail::UncountAllocation( const TypeInfo& type ) noexcept
+	{
+		// Only counted objects are uncounted, so their counters already exist.
+		getTypeStatsRegistry( ).Find( type.Id( ) )->live.fetch_sub( 1 , std::memory_order_relaxed );
+	}
+#ifdef UC_INTRUSIVE_GCPTR
+	void _Detail::UncountAllocation( const RefCounted& obj ) noexcept { UncountAllocation( static_cast< const Object& >( obj ).GetTypeInfo( ) ); }
+#endif
+
+	TypeStatsEntry makeTypeStatsEntry( const TypeCounters& counters , const TypeInfo& type )
+	{
+		TypeStatsEntry entry;
+		entry.Name = type.Name( );
+		entry.Live = counters.live.load( std::memory_order_relaxed );
+		entry.TotalAllocated = counters.allocated.load( std::memory_order_relaxed );
+		entry.ObjectSize = counters.objectSize.load( std::memory_order_relaxed );
+		entry.Bytes = static_cast<uint64_t>( std::max<int64_t>( entry.Live , 0 ) ) * entry.ObjectSize;
+		return entry;
+	}
+	NatVector<TypeStatsEntry> TypeStats::Snapshot( )
+	{
+		decltype( auto ) registry = getTypeStatsRegistry( );
+		NatVector<TypeStatsEntry> entries;
+		for ( const auto& slot : registry.chunks )
+		{
+			auto chunk = slot.load( std::memory_order_acquire );
+			if ( chunk == nullptr ) continue;
+			for ( size_t i = 0; i < TypeStatsRegistry::chunkSize; i++ )
+				if ( auto type = chunk[ i ].info.load( std::memory_order_relaxed ) )
+					entries.push_back( makeTypeStatsEntry( chunk[ i ] , *type ) );
+		}
+		std::sort( entries.begin( ) , entries.end( ) , [ ] ( const TypeStatsEntry& a , const TypeStatsEntry& b )
+		{ return a.Bytes != b.Bytes ? a.Bytes > b.Bytes : a.Name < b.Name; } );
+		return entries;
+	}
+	TypeStatsEntry TypeStats::Get( std::string_view typeName )
+	{
+		decltype( auto ) registry = getTypeStatsRegistry( );
+		for ( const auto& slot : registry.chunks )
+		{
+			auto chunk = slot.load( std::memory_order_acquire );
+			if ( chunk == nullptr ) continue;
+			for ( size_t i = 0; i < TypeStatsRegistry::chunkSize; i++ )
+				if ( auto type = chunk[ i ].info.load( std::memory_order_relaxed ); type != nullptr && type->Name( ) == typeName )
+					return makeTypeStatsEntry( chunk[ i ] , *type );
+		}
+		TypeStatsEntry entry;
+		entry.Name = NatString( typeName );
+		return entry;
+	}
+	void TypeStats::Dump( std::ostream& out , size_t top )
+	{
+		auto entries = Snapshot( );
+		if ( top != 0 && entries.size( ) > top ) entries.resize( top );
+		std::ostringstream str;
+		str << "UC::TypeStats: " << entries.size( ) << " types\n";
+		for ( const auto& entry : entries )
+			str << '\t' << entry.Name << ": " << entry.Live << " live (" << entry.Bytes << " bytes of " << entry.ObjectSize << " each), " << entry.TotalAllocated << " allocated\n";
+		out << str.str( ) << std::flush;
+	}
+
+	struct PeriodicTypeStatsDump
+	{
+		boost::mutex mtx;
+		boost::thread thread;
+	};
+	PeriodicTypeStatsDump& getPeriodicTypeStatsDump( )
+	{
+		static PeriodicTypeStatsDump dump {};
+		return dump;
+	}
+	void TypeStats::StartPeriodicDump( std::chrono::milliseconds interval , std::ostream& out , size_t top )
+	{
+		StopPeriodicDump( );
+		decltype( auto ) dump = getPeriodicTypeStatsDump( );
+		boost::lock_guard<boost::mutex> __lock( dump.mtx );
+		dump.thread = boost::thread( [ interval , &out , top ] ( )
+		{
+			try
+			{
+				while ( true )
+				{
+					boost::this_thread::sleep_for( boost::chrono::milliseconds( interval.count( ) ) );
+					Dump( out , top );
+				}
+			}
+			catch ( const boost::thread_interrupted& ) { }
+		} );
+	}
+	void TypeStats::StopPeriodicDump( )
+	{
+		decltype( auto ) dump = getPeriodicTypeStatsDump( );
+		boost::lock_guard<boost::mutex> __lock( dump.mtx );
+		if ( !dump.thread.joinable( ) ) return;
+		dump.thread.interrupt( );
+		dump.thread.join( );
+	}
+
 	Object::~Object( ) = default;
 	NatString Object::ToString( ) const { return GetTypeName( ); }
 	int64_t Object::GetHashCode( ) const { return Hash( ME ); }
-	P<Object> Object::CreateInstance( const NatString& className , const NatOVector& args )
+	P<Object> Object::CreateInstance( std::string_view className , ArgSpan args )
 	{
-		decltype( auto ) map = getClassCtors( );
-		auto findName = className.substr( 0 , className.find( "<" ) );
-		auto itr = map.find( findName );
-		if ( itr != map.end( ) ) return itr->second( args );
+		auto& ctors = getClassRegistry( ).ctors;
+		auto findName = className.substr( 0 , className.find( '<' ) );
+		auto itr = ctors.find( findName );
+		if ( itr != ctors.end( ) ) return itr->second.ctor( args );
 		else
 			throw UC::NoSuchRegisteredType_Exception( UC::ConcatNatStrings(
 				"There is no *registered* type with the name \"" ,
@@ -25,12 +539,128 @@ namespace UC
 				std::to_string( args.size( ) ) ,
 				" parameters." ) );
 	}
+	TypeHandle Object::ResolveType( std::string_view className )
+	{
+		auto& ctors = getClassRegistry( ).ctors;
+		auto findName = className.substr( 0 , className.find( '<' ) );
+		auto itr = ctors.find( findName );
+		if ( itr != ctors.end( ) ) return TypeHandle( itr->second.name , itr->second.ctor );
+		throw UC::NoSuchRegisteredType_Exception( UC::ConcatNatStrings(
+			"There is no *registered* type with the name \"" ,
+			findName ,
+			"\"." ) );
+	}
 	Object::Object( ) = default;
+	void Object::throwNoSuchFunction( const _Detail::MethodRef& fname , size_t argsLen ) const
+	{
+		throw NoSuchFunction_Exception( ConcatNatStrings(
+			"No function for type \"" ,
+			GetTypeName( ) ,
+			"\" with name \"" ,
+			fname.name ,
+			"\" that takes in " ,
+			std::to_string( argsLen ) ,
+			" parameters." ) );
+	}
 	void Object::addConstructor( const NatString& className , CtorT ctor )
 	{
-		decltype( auto ) map = getClassCtors( );
-		if ( map.emplace( className , ctor ).second == false )
-			throw RepeatingClassNameException( std::move( className ) );
+		decltype( auto ) registry = getClassRegistry( );
+		if ( registry.ctors.find( className ) != registry.ctors.end( ) )
+			throw RepeatingClassNameException( className );
+		auto& name = registry.names.emplace_back( className );
+		registry.ctors.emplace( std::string_view( name ) , ClassRegistry::Entry { &name , ctor } );
+	}
+
+	P<Object> CallSiteCache::miss( Object& obj , const _Detail::SelectorInfo* selector , ArgSpan args )
+	{
+		++misses;
+		if ( totalsEnabled.load( std::memory_order_relaxed ) ) totalMisses.fetch_add( 1 , std::memory_order_relaxed );
+		const _Detail::MethodRef fname( Selector { selector } );
+		auto method = obj.resolveDispatch( fname , args.size( ) );
+		if ( method == nullptr ) obj.throwNoSuchFunction( fname , args.size( ) );
+		entries[ next ] = Entry { &obj.GetTypeName( ) , selector , args.size( ) , method };
+		next = ( next + 1 ) % Capacity;
+		return method->thunk( obj , args );
+	}
+	void CallSiteCache::findSelector( const char* address , std::string_view fname )
+	{
+		auto selector = Selector::Find( fname );
+		lastName = address;
+		lastSelector = selector ? selector->info : nullptr;
+	}
+	P<Object> CallSiteCache::missNamed( Object& obj , std::string_view fname , ArgSpan args )
+	{
+		++misses;
+		if ( totalsEnabled.load( std::memory_order_relaxed ) ) totalMisses.fetch_add( 1 , std::memory_order_relaxed );
+		const NatString name( fname );
+		const _Detail::MethodRef ref( name );
+		auto method = obj.resolveDispatch( ref , args.size( ) );
+		if ( method == nullptr ) obj.throwNoSuchFunction( ref , args.size( ) );
+		// Only the names of methods that exist are interned, so names that are never found can't grow the selector table.
+		lastSelector = method->selector != nullptr ? method->selector : Selector::Intern( fname ).info;
+		entries[ next ] = Entry { &obj.GetTypeName( ) , lastSelector , args.size( ) , method };
+		next = ( next + 1 ) % Capacity;
+		return method->thunk( obj , args );
+	}
+	void CallSiteCache::Clear( ) noexcept
+	{
+		for ( auto& entry : entries ) entry = Entry { };
+		next = 0;
+		lastName = nullptr;
+		lastSelector = nullptr;
+		hits = misses = 0;
+	}
+	void CallSiteCache::ResetTotals( ) noexcept
+	{
+		totalHits.store( 0 , std::memory_order_relaxed );
+		totalMisses.store( 0 , std::memory_order_relaxed );
+	}
+
+	const _Detail::MethodEntry* _Detail::BatchResolver::resolveSlow( Object& obj )
+	{
+		const auto id = obj.TypeId( );
+		if ( id >= methods.size( ) ) methods.resize( std::max<size_t>( id + 1 , TypeInfo::Count( ) ) , nullptr );
+		auto method = obj.resolveDispatch( fname , arity );
+		if ( method == nullptr ) obj.throwNoSuchFunction( fname , arity );
+		return methods[ id ] = method;
+	}
+	void _Detail::RunInParallel( size_t count , const std::function<void( size_t from , size_t to )>& body )
+	{
+		// Small ranges aren't worth the cost of starting threads.
+		constexpr size_t minChunk = 1024;
+		const size_t chunks = std::min<size_t>( std::max( boost::thread::hardware_concurrency( ) , 1u ) , count / minChunk );
+		if ( chunks <= 1 ) return body( 0 , count );
+		NatVector<std::exception_ptr> errors( chunks );
+		boost::thread_group threads;
+		try
+		{
+			for ( size_t i = 1; i < chunks; i++ )
+				threads.create_thread( [ & , i ] ( )
+				{
+					try { body( count * i / chunks , count * ( i + 1 ) / chunks ); }
+					catch ( ... ) { errors[ i ] = std::current_exception( ); }
+				} );
+			body( 0 , count / chunks );
+		}
+		catch ( ... ) { errors[ 0 ] = std::current_exception( ); }
+		threads.join_all( );
+		for ( auto& error : errors ) if ( error ) std::rethrow_exception( error );
+	}
+
+	_Detail::MethodTable::MethodTable( std::initializer_list<MethodEntry> entries )
+	{
+		// Keep the load factor at or below 0.5 so that probe sequences stay short.
+		size_t cap = 2;
+		while ( cap < entries.size( ) * 2 ) cap *= 2;
+		slots.resize( cap );
+		mask = cap - 1;
+		for ( auto& entry : entries )
+		{
+			size_t i = entry.key & mask;
+			while ( slots[ i ].thunk != nullptr ) i = ( i + 1 ) & mask;
+			slots[ i ] = entry;
+			slots[ i ].selector = Selector::Intern( std::string_view( entry.name , entry.nameLen ) ).info;
+		}
 	}
 
 	UCRegister( Int16 );
@@ -47,19 +677,238 @@ namespace UC
 	UCRegister( SByte );
 	UCRegister( Bool );
 
+#pragma region String Search Kernels
+	namespace _Detail
+	{
+		SimdLevel detectSimdLevel( ) noexcept
+		{
+#ifndef __UC_SIMD_X86
+			return SimdLevel::Scalar;
+#elif defined(_MSC_VER)
+			int info[ 4 ];
+			__cpuid( info , 0 );
+			if ( info[ 0 ] < 7 ) return SimdLevel::SSE2;
+			__cpuid( info , 1 );
+			// The OS must save the AVX registers too.
+			const bool osxsave = ( info[ 2 ] & ( 1 << 27 ) ) != 0 , avx = ( info[ 2 ] & ( 1 << 28 ) ) != 0;
+			if ( !osxsave || !avx || ( _xgetbv( 0 ) & 6 ) != 6 ) return SimdLevel::SSE2;
+			__cpuidex( info , 7 , 0 );
+			return ( info[ 1 ] & ( 1 << 5 ) ) != 0 ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#else
+			return __builtin_cpu_supports( "avx2" ) ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#endif
+		}
+		// Both are Scalar until they are initialized, so Strings compared during static initialization are safe.
+		const SimdLevel supportedSimdLevel = detectSimdLevel( );
+		std::atomic<SimdLevel> simdLevel { supportedSimdLevel };
+
+		forceinline unsigned countTrailingZeros( uint32_t mask ) noexcept
+		{
+#ifdef _MSC_VER
+			unsigned long idx;
+			_BitScanForward( &idx , mask );
+			return idx;
+#else
+			return __builtin_ctz( mask );
+#endif
+		}
+
+		size_t scalarFindByte( const char* data , size_t size , char c ) noexcept
+		{
+			auto found = static_cast< const char* >( std::memchr( data , c , size ) );
+			return found == nullptr ? std::string_view::npos : found - data;
+		}
+		size_t scalarCountByte( const char* data , size_t size , char c ) noexcept { return std::count( data , data + size , c ); }
+
+#ifdef __UC_SIMD_X86
+		size_t sse2FindByte( const char* data , size_t size , char c ) noexcept
+		{
+			const __m128i pattern = _mm_set1_epi8( c );
+			size_t i = 0;
+			for ( ; i + 16 <= size; i += 16 )
+			{
+				const auto mask = static_cast< uint32_t >( _mm_movemask_epi8( _mm_cmpeq_epi8( pattern , _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + i ) ) ) ) );
+				if ( mask != 0 ) return i + countTrailingZeros( mask );
+			}
+			const auto idx = scalarFindByte( data + i , size - i , c );
+			return idx == std::string_view::npos ? idx : i + idx;
+		}
+		size_t sse2CountByte( const char* data , size_t size , char c ) noexcept
+		{
+			const __m128i pattern = _mm_set1_epi8( c );
+			size_t i = 0 , count = 0;
+			for ( ; i + 16 <= size; i += 16 )
+				count += std::bitset<16>( _mm_movemask_epi8( _mm_cmpeq_epi8( pattern , _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + i ) ) ) ) ).count( );
+			return count + scalarCountByte( data + i , size - i , c );
+		}
+		// Finds the blocks where both the first & last characters of the needle match, & only compares the rest of the needle there.
+		size_t sse2FindSubstring( const char* data , size_t size , const char* needle , size_t needleSize ) noexcept
+		{
+			const __m128i first = _mm_set1_epi8( needle[ 0 ] ) , last = _mm_set1_epi8( needle[ needleSize - 1 ] );
+			size_t i = 0;
+			for ( ; i + needleSize - 1 + 16 <= size; i += 16 )
+			{
+				const __m128i blockFirst = _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + i ) );
+				const __m128i blockLast = _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + i + needleSize - 1 ) );
+				auto mask = static_cast< uint32_t >( _mm_movemask_epi8( _mm_and_si128( _mm_cmpeq_epi8( first , blockFirst ) , _mm_cmpeq_epi8( last , blockLast ) ) ) );
+				for ( ; mask != 0; mask &= mask - 1 )
+				{
+					const auto idx = i + countTrailingZeros( mask );
+					if ( std::memcmp( data + idx + 1 , needle + 1 , needleSize - 2 ) == 0 ) return idx;
+				}
+			}
+			const auto idx = std::string_view( data + i , size - i ).find( std::string_view( needle , needleSize ) );
+			return idx == std::string_view::npos ? idx : i + idx;
+		}
+		bool sse2EqualBytes( const char* a , const char* b , size_t size ) noexcept
+		{
+			size_t i = 0;
+			for ( ; i + 16 <= size; i += 16 )
+			{
+				const __m128i eq = _mm_cmpeq_epi8( _mm_loadu_si128( reinterpret_cast< const __m128i* >( a + i ) ) , _mm_loadu_si128( reinterpret_cast< const __m128i* >( b + i ) ) );
+				if ( _mm_movemask_epi8( eq ) != 0xFFFF ) return false;
+			}
+			return std::memcmp( a + i , b + i , size - i ) == 0;
+		}
+
+		__UC_TARGET_AVX2 size_t avx2FindByte( const char* data , size_t size , char c ) noexcept
+		{
+			const __m256i pattern = _mm256_set1_epi8( c );
+			size_t i = 0;
+			for ( ; i + 32 <= size; i += 32 )
+			{
+				const auto mask = static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( pattern , _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + i ) ) ) ) );
+				if ( mask != 0 ) return i + countTrailingZeros( mask );
+			}
+			const auto idx = sse2FindByte( data + i , size - i , c );
+			return idx == std::string_view::npos ? idx : i + idx;
+		}
+		__UC_TARGET_AVX2 size_t avx2CountByte( const char* data , size_t size , char c ) noexcept
+		{
+			const __m256i pattern = _mm256_set1_epi8( c );
+			size_t i = 0 , count = 0;
+			for ( ; i + 32 <= size; i += 32 )
+				count += std::bitset<32>( static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( pattern , _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + i ) ) ) ) ) ).count( );
+			return count + sse2CountByte( data + i , size - i , c );
+		}
+		__UC_TARGET_AVX2 size_t avx2FindSubstring( const char* data , size_t size , const char* needle , size_t needleSize ) noexcept
+		{
+			const __m256i first = _mm256_set1_epi8( needle[ 0 ] ) , last = _mm256_set1_epi8( needle[ needleSize - 1 ] );
+			size_t i = 0;
+			for ( ; i + needleSize - 1 + 32 <= size; i += 32 )
+			{
+				const __m256i blockFirst = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + i ) );
+				const __m256i blockLast = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + i + needleSize - 1 ) );
+				auto mask = static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_and_si256( _mm256_cmpeq_epi8( first , blockFirst ) , _mm256_cmpeq_epi8( last , blockLast ) ) ) );
+				for ( ; mask != 0; mask &= mask - 1 )
+				{
+					const auto idx = i + countTrailingZeros( mask );
+					if ( std::memcmp( data + idx + 1 , needle + 1 , needleSize - 2 ) == 0 ) return idx;
+				}
+			}
+			const auto idx = sse2FindSubstring( data + i , size - i , needle , needleSize );
+			return idx == std::string_view::npos ? idx : i + idx;
+		}
+		__UC_TARGET_AVX2 bool avx2EqualBytes( const char* a , const char* b , size_t size ) noexcept
+		{
+			size_t i = 0;
+			for ( ; i + 32 <= size; i += 32 )
+			{
+				const __m256i eq = _mm256_cmpeq_epi8( _mm256_loadu_si256( reinterpret_cast< const __m256i* >( a + i ) ) , _mm256_loadu_si256( reinterpret_cast< const __m256i* >( b + i ) ) );
+				if ( static_cast< uint32_t >( _mm256_movemask_epi8( eq ) ) != 0xFFFFFFFFu ) return false;
+			}
+			return sse2EqualBytes( a + i , b + i , size - i );
+		}
+#endif
+	}
+
+	SimdLevel _Detail::GetSimdLevel( ) noexcept { return simdLevel.load( std::memory_order_relaxed ); }
+	SimdLevel _Detail::SetSimdLevel( SimdLevel level ) noexcept
+	{
+		level = std::min( level , supportedSimdLevel );
+		simdLevel.store( level , std::memory_order_relaxed );
+		return level;
+	}
+
+	size_t _Detail::FindByte( const char* data , size_t size , char c ) noexcept
+	{
+		switch ( GetSimdLevel( ) )
+		{
+#ifdef __UC_SIMD_X86
+		case SimdLevel::AVX2: return avx2FindByte( data , size , c );
+		case SimdLevel::SSE2: return sse2FindByte( data , size , c );
+#endif
+		default: return scalarFindByte( data , size , c );
+		}
+	}
+	size_t _Detail::CountByte( const char* data , size_t size , char c ) noexcept
+	{
+		switch ( GetSimdLevel( ) )
+		{
+#ifdef __UC_SIMD_X86
+		case SimdLevel::AVX2: return avx2CountByte( data , size , c );
+		case SimdLevel::SSE2: return sse2CountByte( data , size , c );
+#endif
+		default: return scalarCountByte( data , size , c );
+		}
+	}
+	size_t _Detail::FindSubstring( std::string_view haystack , std::string_view needle , size_t pos ) noexcept
+	{
+		if ( pos > haystack.size( ) ) return std::string_view::npos;
+		if ( needle.empty( ) ) return pos;
+		const auto data = haystack.data( ) + pos;
+		const auto size = haystack.size( ) - pos;
+		if ( needle.size( ) > size ) return std::string_view::npos;
+		size_t idx;
+		if ( needle.size( ) == 1 ) idx = FindByte( data , size , needle[ 0 ] );
+		else switch ( GetSimdLevel( ) )
+		{
+#ifdef __UC_SIMD_X86
+		case SimdLevel::AVX2: idx = avx2FindSubstring( data , size , needle.data( ) , needle.size( ) ); break;
+		case SimdLevel::SSE2: idx = sse2FindSubstring( data , size , needle.data( ) , needle.size( ) ); break;
+#endif
+		default: idx = std::string_view( data , size ).find( needle ); break;
+		}
+		return idx == std::string_view::npos ? idx : pos + idx;
+	}
+	size_t _Detail::CountSubstring( std::string_view haystack , std::string_view needle ) noexcept
+	{
+		if ( needle.empty( ) ) return 0;
+		if ( needle.size( ) == 1 ) return CountByte( haystack.data( ) , haystack.size( ) , needle[ 0 ] );
+		size_t count = 0;
+		for ( auto idx = FindSubstring( haystack , needle ); idx != std::string_view::npos; idx = FindSubstring( haystack , needle , idx + needle.size( ) ) )
+			count++;
+		return count;
+	}
+	bool _Detail::EqualBytes( const char* a , const char* b , size_t size ) noexcept
+	{
+		if ( a == b || size == 0 ) return true;
+		switch ( GetSimdLevel( ) )
+		{
+#ifdef __UC_SIMD_X86
+		case SimdLevel::AVX2: return avx2EqualBytes( a , b , size );
+		case SimdLevel::SSE2: return sse2EqualBytes( a , b , size );
+#endif
+		default: return std::memcmp( a , b , size ) == 0;
+		}
+	}
+#pragma endregion
+
 	UCRegister( String );
 
-	UCMethod( String::ULength ) { return Int64::Make( NLength( ) ); }
-	UCMethod( String::UContains , ( s ) ) { return Bool::Make( NContains( UCCast( String , s ) ) ); }
-	UCMethod( String::UEndsWith , ( s ) ) { return Bool::Make( NEndsWith( UCCast( String , s ) ) ); }
-	UCMethod( String::UStartsWith , ( s ) )
-	{ return Bool::Make( NStartsWith( UCCast( String , s ) ) ); }
-	UCMethod( String::UEquals , ( s ) ) { return Bool::Make( NEquals( UCCast( String , s ) ) ); }
+	UCTypedMethod( int64_t , String::ULength ) { return NLength( ); }
+	UCTypedMethod( bool , String::UContains , ( s ) ) { return NContains( UCCast( String , s ) ); }
+	UCTypedMethod( bool , String::UEndsWith , ( s ) ) { return NEndsWith( UCCast( String , s ) ); }
+	UCTypedMethod( bool , String::UStartsWith , ( s ) )
+	{ return NStartsWith( UCCast( String , s ) ); }
+	UCTypedMethod( bool , String::UEquals , ( s ) ) { return NEquals( UCCast( String , s ) ); }
+	UCTypedMethod( int64_t , String::UIndexOf , ( s ) ) { return NIndexOf( UCCast( String , s ) ); }
+	UCTypedMethod( int64_t , String::UCount , ( s ) ) { return NCount( UCCast( String , s ) ); }
 	UCMethod( String::USubstring , ( startIdx ) ) { return NSubstring( UCAsUInt64( startIdx ) ); }
 	UCMethod( String::USubstring , ( startIdx , count ) )
 	{ return NSubstring( UCAsUInt64( startIdx ) , UCAsUInt64( count ) ); }
 
-	UCMethod( String::Get , ( Idx ) ) { return Byte::Make( static_cast< byte >( value[ UCAsUInt64( Idx ) ] ) ); }
+	UCTypedMethod( byte , String::Get , ( Idx ) ) { return static_cast< byte >( View( )[ UCAsUInt64( Idx ) ] ); }
 	UCMethod( String::OpAdd , ( _1 ) ) { return Concat( ME , UCCast( String , _1 ) ); }
 	UCMethod( String::OpAdd , ( _1 , _2 ) ) { return Concat( ME , UCCast( String , _1 ) , UCCast( String , _2 ) ); }
 	UCMethod( String::OpAdd , ( _1 , _2 , _3 ) ) { return Concat( ME , UCCast( String , _1 ) , UCCast( String , _2 ) , UCCast( String , _3 ) ); }
@@ -71,6 +920,215 @@ namespace UC
 	UCMethod( String::OpAdd , ( _1 , _2 , _3 , _4 , _5 , _6 , _7 , _8 , _9 ) ) { return Concat( ME , UCCast( String , _1 ) , UCCast( String , _2 ) , UCCast( String , _3 ) , UCCast( String , _4 ) , UCCast( String , _5 ) , UCCast( String , _6 ) , UCCast( String , _7 ) , UCCast( String , _8 ) , UCCast( String , _9 ) ); }
 	UCMethod( String::OpAdd , ( _1 , _2 , _3 , _4 , _5 , _6 , _7 , _8 , _9 , _10 ) ) { return Concat( ME , UCCast( String , _1 ) , UCCast( String , _2 ) , UCCast( String , _3 ) , UCCast( String , _4 ) , UCCast( String , _5 ) , UCCast( String , _6 ) , UCCast( String , _7 ) , UCCast( String , _8 ) , UCCast( String , _9 ) , UCCast( String , _10 ) ); }
 
+	// Guards the children of a rope, the ropes are spread over a fixed set of mutexes by their address.
+	// It is only taken to read or release the children of a rope, never while the characters are copied, nor to read a flat String.
+	boost::mutex& getStringRopeMutex( const String* s )
+	{
+		struct alignas( 64 ) Stripe { boost::mutex mtx; };
+		static Stripe stripes[ 64 ] {};
+		return stripes[ ( reinterpret_cast< uintptr_t >( s ) >> 6 ) % 64 ].mtx;
+	}
+
+	String::String( RopeTag , pcself&& l , pcself&& r ) :
+		lazy( std::make_unique<Lazy>( l->charCount( ) + r->charCount( ) , static_cast< uint8_t >( 1 + std::max( l->ropeDepth( ) , r->ropeDepth( ) ) ) ) )
+	{
+		lazy->left = std::move( l );
+		lazy->right = std::move( r );
+	}
+	String::String( ViewTag , pcself&& root , size_t offset_ , size_t length_ ) :
+		lazy( std::make_unique<Lazy>( length_ , 0 , std::move( root ) , offset_ ) )
+	{ }
+
+	String::pself String::NSubstring( size_t startIndex , size_t count ) const
+	{
+		const auto chars = View( ).substr( startIndex , count );
+		if ( chars.size( ) == charCount( ) ) return mutableFrom( ME );
+		if ( chars.size( ) < UC_STRING_VIEW_MIN_LENGTH ) return MakeFrom( str_t( chars ) );
+		// A view of a view refers to the same flat String, so views never chain.
+		if ( IsView( ) ) return _Detail::MakeGC<self>( ViewTag { } , pcself( lazy->parent ) , lazy->offset + startIndex , chars.size( ) );
+		return _Detail::MakeGC<self>( ViewTag { } , pcself( ME ) , startIndex , chars.size( ) );
+	}
+
+	void String::flatten( ) const
+	{
+		if ( isFlat( ) ) return;
+		// The characters are copied without holding any lock, if two threads flatten the same String the copy of the second is dropped.
+		str_t str;
+		if ( lazy->parent != nullptr ) str.assign( lazy->parent->value , lazy->offset , charCount( ) );
+		else
+		{
+			pcself l , r;
+			if ( !children( l , r ) ) return;
+			str.reserve( charCount( ) );
+			// The right children are pushed first, so the pieces are popped in order.
+			// The nodes are held by the walk, as another thread flattening one of them may release its children meanwhile.
+			NatVector<pcself> pending;
+			pending.push_back( std::move( r ) );
+			pending.push_back( std::move( l ) );
+			while ( !pending.empty( ) )
+			{
+				const pcself node = std::move( pending.back( ) );
+				pending.pop_back( );
+				if ( node->IsView( ) ) str.append( node->lazy->parent->value , node->lazy->offset , node->charCount( ) );
+				else if ( node->children( l , r ) )
+				{
+					pending.push_back( std::move( r ) );
+					pending.push_back( std::move( l ) );
+				}
+				else str += node->value;
+			}
+		}
+		boost::lock_guard<boost::mutex> __lock( getStringRopeMutex( this ) );
+		if ( lazy->flat.load( std::memory_order_relaxed ) ) return;
+		value = std::move( str );
+		// The parent of a view can't be released, as View may be reading it concurrently.
+		lazy->left.Reset( );
+		lazy->right.Reset( );
+		lazy->flat.store( true , std::memory_order_release );
+	}
+
+	bool String::children( pcself& l , pcself& r ) const
+	{
+		if ( isFlat( ) || lazy->depth == 0 ) return false;
+		boost::lock_guard<boost::mutex> __lock( getStringRopeMutex( this ) );
+		if ( lazy->flat.load( std::memory_order_relaxed ) ) return false;
+		l = lazy->left;
+		r = lazy->right;
+		return true;
+	}
+
+	String::pcself String::makeRope( pcself&& l , pcself&& r )
+	{
+		pcself rope = _Detail::MakeGC<self>( RopeTag { } , std::move( l ) , std::move( r ) );
+		if ( rope->lazy->depth > UC_STRING_ROPE_MAX_DEPTH ) rope->flatten( );
+		return rope;
+	}
+
+	String::pcself String::joinFlat( const pcself& l , const pcself& r )
+	{
+		str_t str;
+		str.reserve( l->charCount( ) + r->charCount( ) );
+		str += l->View( );
+		str += r->View( );
+		return MakeFrom( std::move( str ) );
+	}
+
+	String::pcself String::join( pcself l , pcself r )
+	{
+		if ( l->charCount( ) == 0 ) return r;
+		if ( r->charCount( ) == 0 ) return l;
+		if ( l->charCount( ) + r->charCount( ) < UC_STRING_ROPE_MIN_LENGTH ) return joinFlat( l , r );
+		pcself ll , lr , rl , rr;
+		// A short piece is merged with the piece at the end of the rope it is added to, so adding a character at a time doesn't make a node per character.
+		if ( r->charCount( ) < UC_STRING_ROPE_MIN_LENGTH && l->children( ll , lr ) && lr->charCount( ) + r->charCount( ) < UC_STRING_ROPE_MIN_LENGTH )
+			return join( std::move( ll ) , joinFlat( lr , r ) );
+		if ( l->charCount( ) < UC_STRING_ROPE_MIN_LENGTH && r->children( rl , rr ) && l->charCount( ) + rl->charCount( ) < UC_STRING_ROPE_MIN_LENGTH )
+			return join( joinFlat( l , rl ) , std::move( rr ) );
+
+		// The taller side is descended until the depths are within 1 of each other, then rotated back up like in an AVL tree.
+		const auto dl = l->ropeDepth( ) , dr = r->ropeDepth( );
+		if ( dl > dr + 1 && l->children( ll , lr ) )
+		{
+			auto t = join( std::move( lr ) , std::move( r ) );
+			pcself tl , tr , tll , tlr;
+			if ( t->ropeDepth( ) <= ll->ropeDepth( ) + 1 || !t->children( tl , tr ) ) return makeRope( std::move( ll ) , std::move( t ) );
+			if ( tl->ropeDepth( ) > tr->ropeDepth( ) && tl->children( tll , tlr ) )
+				return makeRope( makeRope( std::move( ll ) , std::move( tll ) ) , makeRope( std::move( tlr ) , std::move( tr ) ) );
+			return makeRope( makeRope( std::move( ll ) , std::move( tl ) ) , std::move( tr ) );
+		}
+		if ( dr > dl + 1 && r->children( rl , rr ) )
+		{
+			auto t = join( std::move( l ) , std::move( rl ) );
+			pcself tl , tr , trl , trr;
+			if ( t->ropeDepth( ) <= rr->ropeDepth( ) + 1 || !t->children( tl , tr ) ) return makeRope( std::move( t ) , std::move( rr ) );
+			if ( tr->ropeDepth( ) > tl->ropeDepth( ) && tr->children( trl , trr ) )
+				return makeRope( makeRope( std::move( tl ) , std::move( trl ) ) , makeRope( std::move( trr ) , std::move( rr ) ) );
+			return makeRope( std::move( tl ) , makeRope( std::move( tr ) , std::move( rr ) ) );
+		}
+		return makeRope( std::move( l ) , std::move( r ) );
+	}
+
+	String::pself String::ConcatI( std::initializer_list<pcself> args )
+	{
+		size_t total = 0;
+		for ( const auto& arg : args ) total += arg->charCount( );
+		if ( total < UC_STRING_ROPE_MIN_LENGTH )
+		{
+			str_t str;
+			str.reserve( total );
+			for ( const auto& arg : args ) str += arg->View( );
+			return MakeFrom( std::move( str ) );
+		}
+		pcself result = GetEmpty( );
+		for ( const auto& arg : args ) result = join( std::move( result ) , arg );
+		return mutableFrom( result );
+	}
+
+	struct StringInternTable
+	{
+		boost::shared_mutex mtx;
+		// The keys view the characters of the interned Strings, which are never changed or freed as the table holds them.
+		std::unordered_map<std::string_view , String::pself> strings;
+	};
+	StringInternTable& getStringInternTable( )
+	{
+		static StringInternTable table {};
+		return table;
+	}
+	NotNull<String::pself> String::Intern( const pself& s )
+	{
+		if ( s->IsInterned( ) ) return NotNull<pself>::Unchecked( s );
+		// Interning a view would keep the String it refers to alive forever.
+		if ( s->IsView( ) ) return Intern( s->View( ) );
+		decltype( auto ) table = getStringInternTable( );
+		std::string_view chars = s->View( );
+		{
+			boost::shared_lock<boost::shared_mutex> __lock( table.mtx );
+			auto itr = table.strings.find( chars );
+			if ( itr != table.strings.end( ) ) return NotNull<pself>::Unchecked( itr->second );
+		}
+		boost::unique_lock<boost::shared_mutex> __lock( table.mtx );
+		auto [itr , inserted] = table.strings.try_emplace( chars , s );
+		if ( inserted ) s->interned.store( true , std::memory_order_relaxed );
+		return NotNull<pself>::Unchecked( itr->second );
+	}
+	NotNull<String::pself> String::Intern( std::string_view s )
+	{
+		auto found = FindInterned( s );
+		if ( found != nullptr ) return NotNull<pself>::Unchecked( std::move( found ) );
+		return Intern( pself( Make( s ) ) );
+	}
+	String::pself String::FindInterned( std::string_view s )
+	{
+		decltype( auto ) table = getStringInternTable( );
+		boost::shared_lock<boost::shared_mutex> __lock( table.mtx );
+		auto itr = table.strings.find( s );
+		return itr != table.strings.end( ) ? itr->second : nullptr;
+	}
+
+	UCRegister( StringBuilder );
+
+	StringBuilder& StringBuilder::Append( const P<Object>& v )
+	{
+		switch ( v->GetNumKind( ) )
+		{
+		case NumKind::Int16: case NumKind::Int32: case NumKind::Int64: case NumKind::SByte:
+			return Append( UCAsInt64( v ) );
+		case NumKind::UInt16: case NumKind::UInt32: case NumKind::UInt64: case NumKind::Byte:
+			return Append( UCAsUInt64( v ) );
+		default:
+			// A String's ToString is quoted.
+			auto str = ObjCast<String>( v );
+			return str != nullptr ? Append( str->View( ) ) : Append( v->ToString( ) );
+		}
+	}
+	UCMethod( StringBuilder::UAppend , ( v ) ) { Append( v ); return ME; }
+	UCMethod( StringBuilder::UAppendLine ) { AppendLine( ); return ME; }
+	UCMethod( StringBuilder::UAppendLine , ( v ) ) { AppendLine( v ); return ME; }
+	UCMethod( StringBuilder::UReserve , ( capacity ) ) { Reserve( UCAsUInt64( capacity ) ); return ME; }
+	UCTypedMethod( int64_t , StringBuilder::ULength ) { return NLength( ); }
+	UCMethod( StringBuilder::UToString ) { return NToString( ); }
+
 	UCRegisterTemplate( Deque , <P<Object>> );
 	UCRegisterTemplate( Vector , <P<Object>> );
 	UCRegisterTemplate( BstDeque , <P<Object>> );
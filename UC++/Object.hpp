@@ -5,6 +5,49 @@
 #include "Interface.hpp"
 #include "byte.hpp"
 #include <boost\type_index.hpp>
+#include <charconv>
+#include <cstring>
+#include <optional>
+
+#ifndef UC_POOL_MAX_BLOCK_SIZE
+#define UC_POOL_MAX_BLOCK_SIZE 256
+#endif // !UC_POOL_MAX_BLOCK_SIZE
+
+#ifndef UC_POOL_MAX_FREE_BLOCKS
+#define UC_POOL_MAX_FREE_BLOCKS 4096
+#endif // !UC_POOL_MAX_FREE_BLOCKS
+
+#ifndef UC_BOX_CACHE_MIN
+#define UC_BOX_CACHE_MIN -128
+#endif // !UC_BOX_CACHE_MIN
+
+#ifndef UC_BOX_CACHE_MAX
+#define UC_BOX_CACHE_MAX 1023
+#endif // !UC_BOX_CACHE_MAX
+
+#ifndef UC_CHECKED_LOCALP
+#ifdef _DEBUG
+#define UC_CHECKED_LOCALP 1
+#else
+#define UC_CHECKED_LOCALP 0
+#endif // _DEBUG
+#endif // !UC_CHECKED_LOCALP
+
+#ifndef UC_LAZY_STACKTRACE_DEPTH
+#define UC_LAZY_STACKTRACE_DEPTH 32
+#endif // !UC_LAZY_STACKTRACE_DEPTH
+
+#ifndef UC_STRING_ROPE_MIN_LENGTH
+#define UC_STRING_ROPE_MIN_LENGTH 128
+#endif // !UC_STRING_ROPE_MIN_LENGTH
+
+#ifndef UC_STRING_ROPE_MAX_DEPTH
+#define UC_STRING_ROPE_MAX_DEPTH 64
+#endif // !UC_STRING_ROPE_MAX_DEPTH
+
+#ifndef UC_STRING_VIEW_MIN_LENGTH
+#define UC_STRING_VIEW_MIN_LENGTH 16
+#endif // !UC_STRING_VIEW_MIN_LENGTH
 
 namespace UC
 {
@@ -88,6 +131,7 @@ namespace UC
 
 
 	class Object;
+	class TypeInfo;
 
 
 #pragma region Native String & Concatenation
@@ -118,17 +162,119 @@ namespace UC
 	{ return SGetTypeName<boost::remove_cv_ref_t<T>>( std::bool_constant<boost::is_detected_v<HasSGTN , boost::remove_cv_ref_t<T>>>( ) ); }
 
 #pragma region Exceptions
+	/// <summary>
+	/// How a UC::Exception captures the stack trace of where it was created.
+	/// </summary>
+	enum class StackTraceMode : uint8_t
+	{
+		// Only for the overrides of the exception types, uses the mode of the base exception type.
+		Inherit ,
+		// Nothing is captured, GetStackTrace returns an empty stack trace.
+		Off ,
+		// The stack trace is captured when the exception is created.
+		On ,
+		// The stack trace is captured for 1 of every N exceptions created, the others are Off.
+		Sampled ,
+		// Only the addresses of up to UC_LAZY_STACKTRACE_DEPTH frames are captured, into a single fixed size buffer, the stack trace is built from them by the first GetStackTrace.
+		// The frames below those are dropped, so the stack trace is truncated.
+		Lazy
+	};
+
+	/// <summary>
+	/// The stack trace capture setting of an exception type.
+	/// </summary>
+	class StackTracePolicy
+	{
+		std::atomic<StackTraceMode> mode;
+		std::atomic<uint32_t> sampleEvery { 1 };
+		std::atomic<uint32_t> counter { 0 };
+	public:
+		constexpr StackTracePolicy( StackTraceMode mode ) noexcept : mode( mode ) { }
+
+		forceinline void Set( StackTraceMode newMode , uint32_t newSampleEvery = 1 ) noexcept
+		{
+			sampleEvery.store( newSampleEvery == 0 ? 1 : newSampleEvery , std::memory_order_relaxed );
+			mode.store( newMode , std::memory_order_relaxed );
+		}
+		forceinline StackTraceMode Mode( ) const noexcept { return mode.load( std::memory_order_relaxed ); }
+		forceinline uint32_t SampleEvery( ) const noexcept { return sampleEvery.load( std::memory_order_relaxed ); }
+		/// <summary>
+		/// Gets the mode for the next exception created, Sampled is resolved to On or Off.
+		/// </summary>
+		forceinline StackTraceMode Next( ) noexcept
+		{
+			const auto current = Mode( );
+			if ( current != StackTraceMode::Sampled ) return current;
+			return counter.fetch_add( 1 , std::memory_order_relaxed ) % SampleEvery( ) == 0 ? StackTraceMode::On : StackTraceMode::Off;
+		}
+	};
+
 	class Exception : public std::exception
 	{
 		using base = std::exception;
+		using frame_ptr_t = boost::stacktrace::frame::native_frame_ptr_t;
 		NatString str;
-		boost::stacktrace::stacktrace stackTrace;
+		mutable boost::stacktrace::stacktrace stackTrace;
+		// The frames captured by StackTraceMode::Lazy, until GetStackTrace builds stackTrace from them.
+		struct LazyFrames
+		{
+			size_t count;
+			frame_ptr_t frames[ UC_LAZY_STACKTRACE_DEPTH + 1 ];
+		};
+		// Only allocated for StackTraceMode::Lazy, so the other exceptions don't carry the buffer, it is shared by the copies of the exception.
+		mutable std::shared_ptr<const LazyFrames> lazyFrames;
+
+		void capture( StackTraceMode mode ) noexcept
+		{
+			if ( mode == StackTraceMode::On ) stackTrace = boost::stacktrace::stacktrace( );
+			else if ( mode == StackTraceMode::Lazy )
+			{
+				try
+				{
+					auto captured = std::make_shared<LazyFrames>( );
+					captured->count = boost::stacktrace::safe_dump_to( captured->frames , sizeof( captured->frames ) );
+					if ( captured->count != 0 ) lazyFrames = std::move( captured );
+				}
+				catch ( const std::bad_alloc& ) { }
+			}
+		}
 	public:
-		Exception( NatString&& str ) noexcept : base( ) , str( str ) , stackTrace( boost::stacktrace::stacktrace( ) ) { }
-		Exception( const NatString& str ) noexcept : base( ) , str( str ) { }
+		Exception( NatString&& str ) noexcept : Exception( std::move( str ) , __UCNextStackTraceMode( ) ) { }
+		Exception( const NatString& str ) noexcept : Exception( NatString( str ) , __UCNextStackTraceMode( ) ) { }
 		virtual char const* what( ) const override { return str.c_str( ); }
 		const NatString& Message( ) const { return str; }
-		const boost::stacktrace::stacktrace& GetStackTrace( ) const { return stackTrace; }
+		/// <summary>
+		/// Gets the stack trace of where the exception was created, it is empty if it wasn't captured.
+		/// </summary>
+		const boost::stacktrace::stacktrace& GetStackTrace( ) const
+		{
+			if ( lazyFrames != nullptr )
+			{
+				stackTrace = boost::stacktrace::stacktrace::from_dump( lazyFrames->frames , lazyFrames->count * sizeof( frame_ptr_t ) );
+				lazyFrames.reset( );
+			}
+			return stackTrace;
+		}
+
+		/// <summary>
+		/// Sets how the UC::Exceptions capture their stack traces, unless their type (or a base of it) overrides it with its own SetStackTraceMode.
+		/// sampleEvery is the N of StackTraceMode::Sampled. It is StackTraceMode::On by default.
+		/// </summary>
+		static void SetStackTraceMode( StackTraceMode mode , uint32_t sampleEvery = 1 ) noexcept
+		{
+			BOOST_ASSERT_MSG( mode != StackTraceMode::Inherit , "The global stack trace mode can't be StackTraceMode::Inherit." );
+			__UCStackTracePolicy( ).Set( mode , sampleEvery );
+		}
+		static StackTraceMode GetStackTraceMode( ) noexcept { return __UCStackTracePolicy( ).Mode( ); }
+	protected:
+		Exception( NatString&& str , StackTraceMode mode ) noexcept : base( ) , str( std::move( str ) ) , stackTrace( 0 , 0 ) { capture( mode ); }
+
+		static StackTracePolicy& __UCStackTracePolicy( ) noexcept
+		{
+			static StackTracePolicy policy( StackTraceMode::On );
+			return policy;
+		}
+		static StackTraceMode __UCNextStackTraceMode( ) noexcept { return __UCStackTracePolicy( ).Next( ); }
 	};
 
 	/// <summary>
@@ -195,7 +341,300 @@ namespace UC
 #pragma endregion
 
 
+#pragma region Object Pools
+	/// <summary>
+	/// The statistics of the object pools used by the UCInterfaces that are UC_IsPooled.
+	/// </summary>
+	struct PoolStats
+	{
+		// The allocations that were served from a pool.
+		uint64_t Hits = 0;
+		// The allocations that had to go to the global allocator.
+		uint64_t Misses = 0;
+		// The free blocks that the pools are holding on to & their total size.
+		uint64_t ResidentBlocks = 0;
+		uint64_t ResidentBytes = 0;
+
+		forceinline double HitRate( ) const noexcept { return Hits + Misses == 0 ? 0.0 : double( Hits ) / double( Hits + Misses ); }
+	};
+
+	namespace _Detail
+	{
+		// Pooled blocks are handed out in multiples of this size.
+		constexpr size_t PoolGranularity = 16;
+		constexpr size_t PoolClassCount = ( UC_POOL_MAX_BLOCK_SIZE + PoolGranularity - 1 ) / PoolGranularity;
+
+		/// <summary>
+		/// The free lists of one thread, one for each block size, every block comes from ::operator new.
+		/// </summary>
+		class ThreadPools
+		{
+			struct FreeBlock { FreeBlock* next; };
+			struct FreeList
+			{
+				FreeBlock* head = nullptr;
+				size_t count = 0;
+			};
+
+			FreeList lists[ PoolClassCount ];
+			// Only written by the owning thread, read by ObjectPools::GetStats.
+			std::atomic<uint64_t> hits { 0 } , misses { 0 } , residentBlocks { 0 } , residentBytes { 0 };
+
+			inline static thread_local ThreadPools* current = nullptr;
+			inline static thread_local bool finished = false;
+
+			static forceinline void bump( std::atomic<uint64_t>& stat , uint64_t by ) noexcept { stat.store( stat.load( std::memory_order_relaxed ) + by , std::memory_order_relaxed ); }
+			static forceinline size_t classOf( size_t size ) noexcept { return ( size - 1 ) / PoolGranularity; }
+			static ThreadPools* create( );
+
+			ThreadPools( );
+		public:
+			ThreadPools( const ThreadPools& ) = delete;
+			~ThreadPools( );
+
+			static forceinline bool IsPoolable( size_t size , size_t alignment ) noexcept
+			{ return size <= UC_POOL_MAX_BLOCK_SIZE && alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__; }
+
+			/// <summary>
+			/// Gets the pools of the calling thread, or nullptr if they were already destroyed because the thread is exiting.
+			/// </summary>
+			static forceinline ThreadPools* Current( )
+			{
+				if ( current != nullptr || finished ) return current;
+				return create( );
+			}
+
+			static forceinline void* AllocateBlock( size_t size )
+			{
+				ThreadPools* pools = Current( );
+				if ( pools == nullptr ) return ::operator new( ( classOf( size ) + 1 ) * PoolGranularity );
+				return pools->Allocate( size );
+			}
+			static forceinline void DeallocateBlock( void* block , size_t size ) noexcept
+			{
+				ThreadPools* pools = finished ? nullptr : current;
+				if ( pools == nullptr ) ::operator delete( block );
+				else pools->Deallocate( block , size );
+			}
+
+			forceinline void* Allocate( size_t size )
+			{
+				const size_t cls = classOf( size );
+				FreeList& list = lists[ cls ];
+				if ( list.head == nullptr )
+				{
+					bump( misses , 1 );
+					return ::operator new( ( cls + 1 ) * PoolGranularity );
+				}
+				FreeBlock* block = list.head;
+				list.head = block->next;
+				--list.count;
+				bump( hits , 1 );
+				bump( residentBlocks , uint64_t( -1 ) );
+				bump( residentBytes , uint64_t( 0 ) - ( cls + 1 ) * PoolGranularity );
+				return block;
+			}
+			forceinline void Deallocate( void* block , size_t size ) noexcept
+			{
+				const size_t cls = classOf( size );
+				FreeList& list = lists[ cls ];
+				if ( list.count >= UC_POOL_MAX_FREE_BLOCKS ) return ::operator delete( block );
+				list.head = ::new( block ) FreeBlock { list.head };
+				++list.count;
+				bump( residentBlocks , 1 );
+				bump( residentBytes , ( cls + 1 ) * PoolGranularity );
+			}
+			/// <summary>
+			/// Returns all the free blocks of this thread to the global allocator.
+			/// </summary>
+			void Trim( ) noexcept;
+
+			PoolStats GetStats( ) const noexcept;
+		};
+
+		/// <summary>
+		/// An allocator that takes single small objects from the free lists of the calling thread & everything else from the global allocator.
+		/// </summary>
+		template<typename T>
+		struct PoolAllocator
+		{
+			using value_type = T;
+
+			forceinline PoolAllocator( ) noexcept = default;
+			template<typename U>
+			forceinline PoolAllocator( const PoolAllocator<U>& ) noexcept { }
+
+			forceinline T* allocate( size_t n )
+			{
+				if ( n == 1 && ThreadPools::IsPoolable( sizeof( T ) , alignof( T ) ) ) return static_cast< T* >( ThreadPools::AllocateBlock( sizeof( T ) ) );
+				return std::allocator<T>( ).allocate( n );
+			}
+			forceinline void deallocate( T* value , size_t n ) noexcept
+			{
+				if ( n == 1 && ThreadPools::IsPoolable( sizeof( T ) , alignof( T ) ) ) ThreadPools::DeallocateBlock( value , sizeof( T ) );
+				else std::allocator<T>( ).deallocate( value , n );
+			}
+
+			template<typename U>
+			forceinline bool operator==( const PoolAllocator<U>& ) const noexcept { return true; }
+			template<typename U>
+			forceinline bool operator!=( const PoolAllocator<U>& ) const noexcept { return false; }
+		};
+	}
+
+	/// <summary>
+	/// The per-thread object pools that the Make functions of the UCInterfaces that are UC_IsPooled allocate from.
+	/// </summary>
+	class ObjectPools
+	{
+	public:
+		/// <summary>
+		/// Gets the statistics summed over all the threads since the last ResetStats.
+		/// </summary>
+		static PoolStats GetStats( );
+		/// <summary>
+		/// Restarts counting the hits & misses, the resident size isn't affected.
+		/// </summary>
+		static void ResetStats( );
+		/// <summary>
+		/// Returns the free blocks held by the calling thread to the global allocator.
+		/// </summary>
+		static void TrimThisThread( );
+	};
+#pragma endregion
+
+
 #pragma region Smart Pointers
+	template<typename TPtr> class NotNull;
+
+#ifdef UC_INTRUSIVE_GCPTR
+	namespace _Detail
+	{
+		/// <summary>
+		/// The intrusive reference counts at the start of every Object, used when UC_INTRUSIVE_GCPTR is defined.
+		/// The object is destroyed when the strong count reaches 0 & its memory is freed when the weak count does.
+		/// </summary>
+		class RefCounted;
+		/// <summary>
+		/// Uncounts obj, which is about to be destroyed, from the TypeStats it was counted in.
+		/// </summary>
+		void UncountAllocation( const RefCounted& obj ) noexcept;
+
+		class RefCounted
+		{
+			// Set in weakRefs for the objects counted in the TypeStats, so that marking them takes no room in the object.
+			static constexpr uint32_t countedFlag = uint32_t( 1 ) << 31;
+
+			mutable std::atomic<uint32_t> strongRefs { 0 };
+			// All the strong references together hold one weak reference.
+			mutable std::atomic<uint32_t> weakRefs { 1 };
+		protected:
+			RefCounted( ) noexcept = default;
+			RefCounted( const RefCounted& ) noexcept { }
+			RefCounted& operator=( const RefCounted& ) noexcept { return *this; }
+			virtual ~RefCounted( ) = default;
+		public:
+			forceinline uint32_t UseCount( ) const noexcept { return strongRefs.load( std::memory_order_relaxed ); }
+			forceinline void AddRef( ) const noexcept { strongRefs.fetch_add( 1 , std::memory_order_relaxed ); }
+			forceinline bool TryAddRef( ) const noexcept
+			{
+				auto count = strongRefs.load( std::memory_order_relaxed );
+				while ( count != 0 )
+					if ( strongRefs.compare_exchange_weak( count , count + 1 , std::memory_order_acq_rel , std::memory_order_relaxed ) ) return true;
+				return false;
+			}
+			forceinline void Release( ) const noexcept
+			{
+				if ( strongRefs.fetch_sub( 1 , std::memory_order_acq_rel ) == 1 )
+				{
+					// The memory is freed through this pointer, so the counts must be at the start of the allocation.
+					BOOST_ASSERT( dynamic_cast< const void* >( this ) == this );
+					if ( weakRefs.load( std::memory_order_relaxed ) & countedFlag ) UncountAllocation( *this );
+					const_cast< RefCounted* >( this )->~RefCounted( );
+					ReleaseWeak( );
+				}
+			}
+			forceinline void AddWeakRef( ) const noexcept { weakRefs.fetch_add( 1 , std::memory_order_relaxed ); }
+			forceinline void ReleaseWeak( ) const noexcept
+			{
+				// The counts are trivially destructible, they stay usable after the object is destroyed until its memory is freed.
+				if ( ( weakRefs.fetch_sub( 1 , std::memory_order_acq_rel ) & ~countedFlag ) == 1 ) ::operator delete( const_cast< RefCounted* >( this ) );
+			}
+			/// <summary>
+			/// Marks the object, which was just made, to be uncounted from the TypeStats when it is destroyed.
+			/// </summary>
+			forceinline void MarkCounted( ) const noexcept { weakRefs.fetch_or( countedFlag , std::memory_order_relaxed ); }
+		};
+	}
+
+	/// <summary>
+	/// GCPtr is a class for reference counted resource management/ARC (Automatic Reference Counting).
+	/// It holds a strong reference to the object inside it.
+	/// With UC_INTRUSIVE_GCPTR it is a single pointer & the count is in the object, so T must be a UCInterface.
+	/// </summary>
+	template<typename T> struct GCPtr
+	{
+		T* ptr;
+		using element_type = T;
+
+		GCPtr<T>& Get( ) { if ( !HasValue( ) )throw NullPointerException( "Trying to dereference a null pointer." ); return *this; }
+		const GCPtr<T>& Get( ) const { if ( !HasValue( ) )throw NullPointerException( "Trying to dereference a null pointer." ); return *this; }
+
+		static const NatString& SGetTypeName( );
+
+		template<class T2>
+		forceinline GCPtr( const GCPtr<T2>& p ) noexcept :ptr( p.ptr ) { addRef( ); }
+		template<class T2>
+		forceinline GCPtr( GCPtr<T2>&& p ) noexcept :ptr( p.ptr ) { p.ptr = nullptr; }
+		forceinline GCPtr( const GCPtr<T>& p ) noexcept :ptr( p.ptr ) { addRef( ); }
+		forceinline GCPtr( GCPtr<T>&& p ) noexcept :ptr( p.ptr ) { p.ptr = nullptr; }
+
+		forceinline GCPtr( ) noexcept :ptr { nullptr } { }
+		forceinline GCPtr( nullptr_t ) noexcept :ptr { nullptr } { }
+		forceinline explicit GCPtr( T* value ) noexcept : ptr( value ) { addRef( ); }
+		forceinline ~GCPtr( ) { release( ); }
+
+		forceinline GCPtr<T>& operator=( const GCPtr<T>& p ) noexcept { GCPtr<T>( p ).swap( *this ); return *this; }
+		forceinline GCPtr<T>& operator=( GCPtr<T>&& p ) noexcept { GCPtr<T>( std::move( p ) ).swap( *this ); return *this; }
+		template<class T2>
+		forceinline GCPtr<T>& operator=( const GCPtr<T2>& p ) noexcept { GCPtr<T>( p ).swap( *this ); return *this; }
+		template<class T2>
+		forceinline GCPtr<T>& operator=( GCPtr<T2>&& p ) noexcept { GCPtr<T>( std::move( p ) ).swap( *this ); return *this; }
+		forceinline void swap( GCPtr<T>& p ) noexcept { std::swap( ptr , p.ptr ); }
+
+		forceinline explicit operator bool( ) const noexcept { return ptr != nullptr; }
+		forceinline GCPtr<T>& Reset( ) noexcept { GCPtr<T>( ).swap( *this ); return *this; }
+		forceinline GCPtr<T>& Reset( T* value ) { GCPtr<T>( value ).swap( *this ); return *this; }
+
+		forceinline T& operator*( ) { Get( ); return *ptr; }
+		forceinline const T& operator*( ) const { Get( ); return *ptr; }
+		forceinline T* operator->( ) { Get( ); return ptr; }
+		forceinline const T* operator->( ) const { Get( ); return ptr; }
+
+		forceinline bool HasValue( ) const noexcept { return ptr != nullptr; }
+
+		forceinline bool operator!=( nullptr_t )const noexcept { return ptr != nullptr; }
+		forceinline bool operator==( nullptr_t )const noexcept { return ptr == nullptr; }
+
+		template<typename T2>
+		forceinline bool RefEq( const GCPtr<T2>& ptr2 )const noexcept { return ptr == ptr2.ptr; }
+		template<typename T2>
+		forceinline bool RefNotEq( const GCPtr<T2>& ptr2 )const noexcept { return ptr != ptr2.ptr; }
+
+		template<typename T>
+		friend struct WeakPtr;
+		template<typename T>
+		friend class EnableGCPtrFromMe;
+	private:
+		static const _Detail::RefCounted* refs( T* value ) noexcept
+		{
+			static_assert( std::is_base_of_v<_Detail::RefCounted , std::remove_cv_t<T>> , "With UC_INTRUSIVE_GCPTR a GCPtr can only hold UCInterfaces." );
+			return value;
+		}
+		forceinline void addRef( ) const noexcept { if ( ptr != nullptr ) refs( ptr )->AddRef( ); }
+		forceinline void release( ) const noexcept { if ( ptr != nullptr ) refs( ptr )->Release( ); }
+	};
+#else
 	/// <summary>
 	/// GCPtr is a class for reference counted resource management/ARC (Automatic Reference Counting).
 	/// It holds a strong reference to the object inside it.
@@ -211,16 +650,30 @@ namespace UC
 		static const NatString& SGetTypeName( );
 
 		template<class T2>
-		forceinline GCPtr( const GCPtr<T2>& p ) :ptr( p.ptr ) { }
+		forceinline GCPtr( const GCPtr<T2>& p ) noexcept :ptr( p.ptr ) { }
 		template<class T2>
-		forceinline GCPtr( const std::shared_ptr<T2>& p ) : ptr( p ) { }
-		forceinline GCPtr( std::shared_ptr<T>&& p ) : ptr( p ) { }
-		forceinline GCPtr( const std::shared_ptr<T>& p ) : ptr( p ) { }
+		forceinline GCPtr( GCPtr<T2>&& p ) noexcept :ptr( std::move( p.ptr ) ) { }
+		template<class T2>
+		forceinline GCPtr( const std::shared_ptr<T2>& p ) noexcept : ptr( p ) { }
+		template<class T2>
+		forceinline GCPtr( std::shared_ptr<T2>&& p ) noexcept : ptr( std::move( p ) ) { }
+		forceinline GCPtr( std::shared_ptr<T>&& p ) noexcept : ptr( std::move( p ) ) { }
+		forceinline GCPtr( const std::shared_ptr<T>& p ) noexcept : ptr( p ) { }
+		GCPtr( const GCPtr<T>& p ) noexcept = default;
+		GCPtr( GCPtr<T>&& p ) noexcept = default;
 
 		forceinline GCPtr( ) noexcept :ptr {  } { }
 		forceinline GCPtr( nullptr_t ) noexcept :ptr { } { }
 		forceinline explicit GCPtr( T* value ) : ptr( value ) { }
 
+		GCPtr<T>& operator=( const GCPtr<T>& p ) noexcept = default;
+		GCPtr<T>& operator=( GCPtr<T>&& p ) noexcept = default;
+		template<class T2>
+		forceinline GCPtr<T>& operator=( const GCPtr<T2>& p ) noexcept { ptr = p.ptr; return *this; }
+		template<class T2>
+		forceinline GCPtr<T>& operator=( GCPtr<T2>&& p ) noexcept { ptr = std::move( p.ptr ); return *this; }
+		forceinline void swap( GCPtr<T>& p ) noexcept { ptr.swap( p.ptr ); }
+
 		forceinline explicit operator bool( ) const noexcept { return ptr != nullptr; }
 		forceinline GCPtr<T>& Reset( ) noexcept { ptr.reset( ); return *this; }
 		forceinline GCPtr<T>& Reset( T* value ) { ptr.reset( value ); return *this; }
@@ -246,6 +699,8 @@ namespace UC
 		friend class EnableGCPtrFromMe;
 	};
 
+#endif
+
 	template<typename T>
 	inline const NatString & UC::GCPtr<T>::SGetTypeName( )
 	{
@@ -266,6 +721,63 @@ namespace UC
 	template<typename T> forceinline bool operator==( nullptr_t , const GCPtr<T>& val )
 	{ return val == nullptr; }
 
+#ifdef UC_INTRUSIVE_GCPTR
+	/// <summary>
+	/// WeakPtr is a smart pointer that holds a non-owning ("weak") reference to an object that is managed by GCPtr. 
+	/// It must be converted to GCPtr (by Lock, LockIfNotThrow/operator *) in order to access the referenced object.
+	/// With UC_INTRUSIVE_GCPTR it is a single pointer that keeps the memory, not the object, of the referenced object alive.
+	/// </summary>
+	template<typename T> struct WeakPtr
+	{
+		T* ptr;
+
+		forceinline WeakPtr( ) noexcept :ptr( nullptr ) { }
+		forceinline WeakPtr( nullptr_t ) noexcept :ptr( nullptr ) { }
+		forceinline WeakPtr( const GCPtr<T>& p ) noexcept :ptr( p.ptr ) { addWeakRef( ); }
+		forceinline WeakPtr( const WeakPtr<T>& p ) noexcept :ptr( p.ptr ) { addWeakRef( ); }
+		forceinline WeakPtr( WeakPtr<T>&& p ) noexcept :ptr( p.ptr ) { p.ptr = nullptr; }
+		template<class T2>
+		forceinline WeakPtr( const WeakPtr<T2>& p ) noexcept : ptr( p.ptr ) { addWeakRef( ); }
+		template<class T2>
+		forceinline WeakPtr( WeakPtr<T2>&& p ) noexcept : ptr( p.ptr ) { p.ptr = nullptr; }
+		forceinline ~WeakPtr( ) { releaseWeak( ); }
+
+		forceinline WeakPtr<T>& operator=( const WeakPtr<T>& p ) noexcept { WeakPtr<T>( p ).swap( *this ); return *this; }
+		forceinline WeakPtr<T>& operator=( WeakPtr<T>&& p ) noexcept { WeakPtr<T>( std::move( p ) ).swap( *this ); return *this; }
+		forceinline void swap( WeakPtr<T>& p ) noexcept { std::swap( ptr , p.ptr ); }
+
+		forceinline WeakPtr<T>& Reset( ) noexcept { WeakPtr<T>( ).swap( *this ); return *this; }
+		forceinline bool Expired( ) const { return ptr == nullptr || GCPtr<T>::refs( ptr )->UseCount( ) == 0; }
+
+		forceinline GCPtr<T> Lock( ) const
+		{
+			GCPtr<T> locked;
+			if ( ptr != nullptr && GCPtr<T>::refs( ptr )->TryAddRef( ) ) locked.ptr = ptr;
+			return locked;
+		}
+		GCPtr<T> LockIfNotThrow( ) const
+		{
+			auto lockedVal = Lock( );
+			if ( lockedVal == nullptr ) throw BadWeakPtrException( "Trying to dereference an expired WeakPtr." );
+			return lockedVal;
+		}
+		forceinline GCPtr<T> operator*( ) { return LockIfNotThrow( ); }
+
+		forceinline explicit operator bool( ) const noexcept { return ptr != nullptr; }
+		forceinline WeakPtr<T>& operator=( const GCPtr<T>& p ) { WeakPtr<T>( p ).swap( *this ); return *this; }
+
+		forceinline bool operator!=( nullptr_t )const noexcept { return ptr != nullptr; }
+		bool operator==( nullptr_t )const noexcept { return ptr == nullptr; }
+
+		template<typename T>
+		friend class EnableGCPtrFromMe;
+	private:
+		struct AdoptTag { };
+		forceinline WeakPtr( T* value , AdoptTag ) noexcept :ptr( value ) { addWeakRef( ); }
+		forceinline void addWeakRef( ) const noexcept { if ( ptr != nullptr ) GCPtr<T>::refs( ptr )->AddWeakRef( ); }
+		forceinline void releaseWeak( ) const noexcept { if ( ptr != nullptr ) GCPtr<T>::refs( ptr )->ReleaseWeak( ); }
+	};
+#else
 	/// <summary>
 	/// WeakPtr is a smart pointer that holds a non-owning ("weak") reference to an object that is managed by GCPtr. 
 	/// It must be converted to GCPtr (by Lock, LockIfNotThrow/operator *) in order to access the referenced object.
@@ -280,6 +792,15 @@ namespace UC
 		forceinline WeakPtr( ) noexcept :wptr( ) { }
 		forceinline WeakPtr( nullptr_t ) noexcept :wptr( ) { }
 		forceinline WeakPtr( const GCPtr<T>& ptr ) noexcept :wptr( ptr.ptr ) { }
+		WeakPtr( const WeakPtr<T>& p ) noexcept = default;
+		WeakPtr( WeakPtr<T>&& p ) noexcept = default;
+		template<class T2>
+		forceinline WeakPtr( const WeakPtr<T2>& p ) noexcept : wptr( p.wptr ) { }
+		template<class T2>
+		forceinline WeakPtr( WeakPtr<T2>&& p ) noexcept : wptr( std::move( p.wptr ) ) { }
+
+		WeakPtr<T>& operator=( const WeakPtr<T>& p ) noexcept = default;
+		WeakPtr<T>& operator=( WeakPtr<T>&& p ) noexcept = default;
 
 		forceinline WeakPtr<T>& Reset( ) noexcept { wptr.reset( ); return *this; }
 		forceinline bool Expired( ) const { return wptr.expired( ); }
@@ -303,12 +824,65 @@ namespace UC
 		friend class EnableGCPtrFromMe;
 	};
 
+#endif
+
 	template<typename T> forceinline bool operator!=( nullptr_t , const WeakPtr<T>& val )
 	{ return val != nullptr; }
 
 	template<typename T> forceinline bool operator==( nullptr_t , const WeakPtr<T>& val )
 	{ return val == nullptr; }
 
+#ifdef UC_INTRUSIVE_GCPTR
+	template<typename T> class EnableGCPtrFromMe
+	{
+		T* me( ) noexcept { return static_cast< T* >( this ); }
+		const T* me( ) const noexcept { return static_cast< const T* >( this ); }
+	public:
+		forceinline NotNull<GCPtr<T>> GCFromMe( )
+		{
+			if ( me( )->UseCount( ) == 0 ) throw BadWeakPtrException( "GCFromMe was called on an object that isn't held by a GCPtr yet." );
+			return NotNull<GCPtr<T>>::Unchecked( GCPtr<T>( me( ) ) );
+		}
+
+		forceinline NotNull<GCPtr<const T>> GCFromMe( ) const
+		{
+			if ( me( )->UseCount( ) == 0 ) throw BadWeakPtrException( "GCFromMe was called on an object that isn't held by a GCPtr yet." );
+			return NotNull<GCPtr<const T>>::Unchecked( GCPtr<const T>( me( ) ) );
+		}
+
+		forceinline WeakPtr<T> WeakFromMe( )noexcept
+		{
+			if ( me( )->UseCount( ) == 0 ) return WeakPtr<T>( );
+			return WeakPtr<T>( me( ) , typename WeakPtr<T>::AdoptTag { } );
+		}
+
+		forceinline WeakPtr<const T> WeakFromMe( ) const noexcept
+		{
+			if ( me( )->UseCount( ) == 0 ) return WeakPtr<const T>( );
+			return WeakPtr<const T>( me( ) , typename WeakPtr<const T>::AdoptTag { } );
+		}
+	};
+
+	namespace _Detail
+	{
+		template<typename T , typename T2> forceinline GCPtr<T> StaticPtrCast( const GCPtr<T2>& v ) { return GCPtr<T>( static_cast< T* >( v.ptr ) ); }
+		template<typename T , typename T2> forceinline GCPtr<T> DynamicPtrCast( const GCPtr<T2>& v ) { return GCPtr<T>( dynamic_cast< T* >( v.ptr ) ); }
+		// The reference of v is taken over, so the count isn't touched.
+		template<typename T , typename T2> forceinline GCPtr<T> StaticPtrCast( GCPtr<T2>&& v ) noexcept
+		{
+			GCPtr<T> ret;
+			ret.ptr = static_cast< T* >( v.ptr );
+			v.ptr = nullptr;
+			return ret;
+		}
+		template<typename T , typename T2> forceinline GCPtr<T> DynamicPtrCast( GCPtr<T2>&& v )
+		{
+			GCPtr<T> ret;
+			if ( ( ret.ptr = dynamic_cast< T* >( v.ptr ) ) != nullptr ) v.ptr = nullptr;
+			return ret;
+		}
+	}
+#else
 	struct virtual_enable_shared_from_this_base :
 		std::enable_shared_from_this<virtual_enable_shared_from_this_base>
 	{
@@ -336,13 +910,14 @@ namespace UC
 		base_t& base( ) { return *this; }
 		const base_t& base( ) const { return *this; }
 	public:
-		forceinline GCPtr<T> GCFromMe( )
+		// shared_from_this throws std::bad_weak_ptr instead of returning null.
+		forceinline NotNull<GCPtr<T>> GCFromMe( )
 		{
-			return GCPtr<T>( base( ).shared_from_this( ) );
+			return NotNull<GCPtr<T>>::Unchecked( GCPtr<T>( base( ).shared_from_this( ) ) );
 		}
 
-		forceinline GCPtr<const T> GCFromMe( ) const
-		{ return GCPtr<const T>( base( ).shared_from_this( ) ); }
+		forceinline NotNull<GCPtr<const T>> GCFromMe( ) const
+		{ return NotNull<GCPtr<const T>>::Unchecked( GCPtr<const T>( base( ).shared_from_this( ) ) ); }
 
 		forceinline WeakPtr<T> WeakFromMe( )noexcept
 		{
@@ -356,6 +931,236 @@ namespace UC
 			catch ( const std::bad_weak_ptr& ) { return  WeakPtr<const T>( ); }
 		}
 	};
+
+	namespace _Detail
+	{
+		template<typename T , typename T2> forceinline GCPtr<T> StaticPtrCast( const GCPtr<T2>& v ) { return std::static_pointer_cast< T >( v.ptr ); }
+		template<typename T , typename T2> forceinline GCPtr<T> DynamicPtrCast( const GCPtr<T2>& v ) { return std::dynamic_pointer_cast< T >( v.ptr ); }
+#if ( defined( _MSVC_LANG ) ? _MSVC_LANG : __cplusplus ) > 201703L
+		template<typename T , typename T2> forceinline GCPtr<T> StaticPtrCast( GCPtr<T2>&& v ) noexcept { return std::static_pointer_cast< T >( std::move( v.ptr ) ); }
+		template<typename T , typename T2> forceinline GCPtr<T> DynamicPtrCast( GCPtr<T2>&& v ) noexcept { return std::dynamic_pointer_cast< T >( std::move( v.ptr ) ); }
+#else
+		// Before C++20 a std::shared_ptr can only be moved into a std::shared_ptr of a base type, downcasts copy & then release v.
+		template<typename T , typename T2> forceinline GCPtr<T> StaticPtrCast( GCPtr<T2>&& v ) noexcept
+		{
+			if constexpr ( std::is_convertible_v<T2* , T*> ) return GCPtr<T>( std::move( v ) );
+			else
+			{
+				GCPtr<T> ret = std::static_pointer_cast< T >( v.ptr );
+				v.ptr.reset( );
+				return ret;
+			}
+		}
+		template<typename T , typename T2> forceinline GCPtr<T> DynamicPtrCast( GCPtr<T2>&& v ) noexcept
+		{
+			if constexpr ( std::is_convertible_v<T2* , T*> ) return GCPtr<T>( std::move( v ) );
+			else
+			{
+				GCPtr<T> ret = std::dynamic_pointer_cast< T >( v.ptr );
+				if ( ret != nullptr ) v.ptr.reset( );
+				return ret;
+			}
+		}
+#endif
+	}
+#endif
+
+	/// <summary>
+	/// A GCPtr that is never null. That is checked once when it is created, so dereferencing it isn't checked.
+	/// ME, asNotNull & the Make functions return it & it can be used wherever a GCPtr can, as it is one.
+	/// It can't be reset, swapped or be assigned a GCPtr, only another NotNull. Like gsl::not_null, moving it into another NotNull copies it,
+	/// so that it stays valid, only moving it into a GCPtr leaves it null, dereferencing it then is asserted against.
+	/// </summary>
+	template<typename T>
+	class NotNull<GCPtr<T>> : public GCPtr<T>
+	{
+		using base_t = GCPtr<T>;
+		struct UncheckedTag { };
+
+		// Hidden so that the pointer can't be nulled through them.
+		using base_t::ptr;
+		using base_t::swap;
+
+		forceinline NotNull( base_t&& p , UncheckedTag ) noexcept : base_t( std::move( p ) ) { BOOST_ASSERT( this->HasValue( ) ); }
+		forceinline void check( ) const { if ( !this->HasValue( ) ) throw NullPointerException( "A null pointer was given to a UC::NotNull." ); }
+		forceinline T* get( ) const noexcept
+		{
+#ifdef UC_INTRUSIVE_GCPTR
+			return this->ptr;
+#else
+			return this->ptr.get( );
+#endif
+		}
+	public:
+		using element_type = T;
+
+		NotNull( ) = delete;
+		NotNull( nullptr_t ) = delete;
+		/// <summary>
+		/// Throws a NullPointerException if p is null.
+		/// </summary>
+		template<typename T2>
+		forceinline explicit NotNull( const GCPtr<T2>& p ) : base_t( p ) { check( ); }
+		template<typename T2>
+		forceinline explicit NotNull( GCPtr<T2>&& p ) : base_t( std::move( p ) ) { check( ); }
+		template<typename T2>
+		forceinline NotNull( const NotNull<GCPtr<T2>>& p ) noexcept : base_t( p ) { }
+		template<typename T2>
+		forceinline NotNull( NotNull<GCPtr<T2>>&& p ) noexcept : base_t( static_cast< const GCPtr<T2>& >( p ) ) { }
+		NotNull( const NotNull& ) = default;
+		// Copies, so that p isn't null afterwards.
+		forceinline NotNull( NotNull&& p ) noexcept : base_t( static_cast< const base_t& >( p ) ) { }
+
+		NotNull& operator=( const NotNull& ) = default;
+		forceinline NotNull& operator=( NotNull&& p ) noexcept { base_t::operator=( static_cast< const base_t& >( p ) ); return *this; }
+		template<typename T2>
+		forceinline NotNull& operator=( const NotNull<GCPtr<T2>>& p ) noexcept { base_t::operator=( p ); return *this; }
+		template<typename T2>
+		forceinline NotNull& operator=( NotNull<GCPtr<T2>>&& p ) noexcept { base_t::operator=( static_cast< const GCPtr<T2>& >( p ) ); return *this; }
+		NotNull& operator=( nullptr_t ) = delete;
+		void Reset( ) = delete;
+
+		/// <summary>
+		/// Wraps p without checking it, p must not be null.
+		/// </summary>
+		static forceinline NotNull Unchecked( base_t p ) noexcept { return NotNull( std::move( p ) , UncheckedTag { } ); }
+
+		forceinline T& operator*( ) noexcept { BOOST_ASSERT( get( ) != nullptr ); return *get( ); }
+		forceinline const T& operator*( ) const noexcept { BOOST_ASSERT( get( ) != nullptr ); return *get( ); }
+		forceinline T* operator->( ) noexcept { BOOST_ASSERT( get( ) != nullptr ); return get( ); }
+		forceinline const T* operator->( ) const noexcept { BOOST_ASSERT( get( ) != nullptr ); return get( ); }
+	};
+
+	namespace _Detail
+	{
+		/// <summary>
+		/// Constructs & destroys UCInterfaces for the generated factories, every UCInterface befriends it so that the constructors can stay protected.
+		/// </summary>
+		struct GCAccess
+		{
+			template<typename T , typename... Args>
+			static forceinline void Construct( T* where , Args&&... args ) { ::new( static_cast< void* >( where ) ) T( std::forward<Args>( args )... ); }
+			template<typename T>
+			static forceinline void Destroy( T* value ) noexcept { value->~T( ); }
+
+			/// <summary>
+			/// Checks if T itself (not just a base of it) is UC_IsPooled.
+			/// </summary>
+			template<typename T>
+			static constexpr bool IsPooled( ) { return isPooled<T>( 0 ); }
+			/// <summary>
+			/// Checks if T is registered with the cycle collector when it is created, i.e. if T or a base of it is UC_HasGCEdges with a field that can hold a P&lt;T&gt;.
+			/// </summary>
+			template<typename T>
+			static constexpr bool IsTraced( ) { return isTraced<T>( 0 ); }
+		private:
+			template<typename T>
+			static constexpr auto isTraced( int ) -> decltype( T::__UCHasGCEdges( ) ) { return T::__UCHasGCEdges( ); }
+			template<typename T>
+			static constexpr bool isTraced( ... ) { return false; }
+			template<typename T>
+			static constexpr auto isPooled( int ) -> decltype( std::is_same<typename T::__UCPooledSelf , T>::value ) { return std::is_same<typename T::__UCPooledSelf , T>::value; }
+			template<typename T>
+			static constexpr bool isPooled( ... ) { return false; }
+		};
+
+		/// <summary>
+		/// Uncounts an object of type, which is being destroyed, from the TypeStats it was counted in.
+		/// </summary>
+		void UncountAllocation( const TypeInfo& type ) noexcept;
+
+		/// <summary>
+		/// Adapts TAlloc to construct through GCAccess, so that std::allocate_shared can place a UCInterface & its control block in a single allocation.
+		/// If Counted, destroying the UCInterface uncounts it from the TypeStats, the copy of the allocator in the control block remembers that for it.
+		/// </summary>
+		template<typename T , typename TAlloc , bool Counted = false>
+		struct GCAllocator
+		{
+			using value_type = T;
+			using inner_type = typename std::allocator_traits<TAlloc>::template rebind_alloc<T>;
+			template<typename U> struct rebind { using other = GCAllocator<U , TAlloc , Counted>; };
+
+			inner_type inner;
+
+			forceinline GCAllocator( const TAlloc& alloc ) :inner( alloc ) { }
+			template<typename U>
+			forceinline GCAllocator( const GCAllocator<U , TAlloc , Counted>& other ) : inner( other.inner ) { }
+
+			forceinline T* allocate( size_t n ) { return std::allocator_traits<inner_type>::allocate( inner , n ); }
+			forceinline void deallocate( T* value , size_t n ) { std::allocator_traits<inner_type>::deallocate( inner , value , n ); }
+			template<typename U , typename... Args>
+			forceinline void construct( U* where , Args&&... args ) { GCAccess::Construct( where , std::forward<Args>( args )... ); }
+			template<typename U>
+			forceinline void destroy( U* value ) noexcept
+			{
+				GCAccess::Destroy( value );
+				if constexpr ( Counted ) UncountAllocation( std::remove_cv_t<U>::SGetTypeInfo( ) );
+			}
+
+			template<typename U>
+			forceinline bool operator==( const GCAllocator<U , TAlloc , Counted>& other ) const noexcept { return inner == other.inner; }
+			template<typename U>
+			forceinline bool operator!=( const GCAllocator<U , TAlloc , Counted>& other ) const noexcept { return inner != other.inner; }
+		};
+
+		// Set by GC::Enable.
+		inline std::atomic<bool> cycleCollectorEnabled { false };
+		/// <summary>
+		/// Registers obj with the cycle collector, as a possible member of a garbage cycle.
+		/// </summary>
+		void TrackCycleCandidate( const GCPtr<Object>& obj );
+
+		// Set by TypeStats::Enable.
+		inline std::atomic<bool> typeStatsEnabled { false };
+		/// <summary>
+		/// Counts an object of type, which was just made, in the TypeStats.
+		/// </summary>
+		void CountAllocation( const TypeInfo& type , size_t size ) noexcept;
+
+		/// <summary>
+		/// Constructs a T whose memory & reference counts come from a single allocation with alloc.
+		/// If T is traced & the cycle collector is enabled it is registered with the cycle collector,
+		/// & it is counted in the TypeStats if they are enabled.
+		/// </summary>
+		template<typename T , typename TAlloc , typename... Args>
+		forceinline NotNull<GCPtr<T>> AllocateGC( const TAlloc& alloc , Args&&... args )
+		{
+			// Decided before the object is made, as it is uncounted when it is destroyed only if it was counted.
+			const bool counted = typeStatsEnabled.load( std::memory_order_relaxed );
+#ifdef UC_INTRUSIVE_GCPTR
+			// The counts are already in the object, but the memory is freed with ::operator delete.
+			static_assert( std::is_same_v<typename std::allocator_traits<TAlloc>::template rebind_alloc<T> , std::allocator<T>> ,
+						   "With UC_INTRUSIVE_GCPTR UCInterfaces can only be allocated by std::allocator." );
+			void* mem = ::operator new( sizeof( T ) );
+			try { GCAccess::Construct( static_cast< T* >( mem ) , std::forward<Args>( args )... ); }
+			catch ( ... ) { ::operator delete( mem ); throw; }
+			GCPtr<T> ret( static_cast< T* >( mem ) );
+			if ( counted ) ret.ptr->MarkCounted( );
+#else
+			GCPtr<T> ret( counted ?
+						  std::allocate_shared<T>( GCAllocator<T , TAlloc , true>( alloc ) , std::forward<Args>( args )... ) :
+						  std::allocate_shared<T>( GCAllocator<T , TAlloc>( alloc ) , std::forward<Args>( args )... ) );
+#endif
+			if constexpr ( GCAccess::IsTraced<T>( ) )
+				if ( cycleCollectorEnabled.load( std::memory_order_relaxed ) ) TrackCycleCandidate( ret );
+			if ( counted ) CountAllocation( T::SGetTypeInfo( ) , sizeof( T ) );
+			return NotNull<GCPtr<T>>::Unchecked( std::move( ret ) );
+		}
+
+		/// <summary>
+		/// Constructs a T whose memory & reference counts come from a single allocation, used by the generated factories.
+		/// The allocation comes from the object pools if T is UC_IsPooled.
+		/// </summary>
+		template<typename T , typename... Args>
+		forceinline NotNull<GCPtr<T>> MakeGC( Args&&... args )
+		{
+#ifndef UC_INTRUSIVE_GCPTR
+			if constexpr ( GCAccess::IsPooled<T>( ) ) return AllocateGC<T>( PoolAllocator<T>( ) , std::forward<Args>( args )... );
+			else
+#endif
+				return AllocateGC<T>( std::allocator<T>( ) , std::forward<Args>( args )... );
+		}
+	}
 #pragma endregion
 
 	/// <summary>
@@ -368,6 +1173,116 @@ namespace UC
 	/// </summary>
 	template<typename T>using W = WeakPtr<T>;
 
+	namespace _Detail
+	{
+		/// <summary>
+		/// The shared state of the LocalPs that came from the same GCPtr.
+		/// </summary>
+		template<typename T>
+		struct LocalBlock
+		{
+			GCPtr<T> owner;
+			size_t refs = 1;
+#if UC_CHECKED_LOCALP
+			boost::thread::id thread = boost::this_thread::get_id( );
+#endif
+			forceinline LocalBlock( GCPtr<T>&& owner ) : owner( std::move( owner ) ) { }
+		};
+	}
+
+	/// <summary>
+	/// A strong reference for objects that are only used by a single thread.
+	/// All the LocalPs copied from one another share a single strong GCPtr reference through a plain, non-atomic count,
+	/// so copying & destroying them doesn't cost any atomic operations.
+	/// A LocalP & its copies must never be used by any thread other than the one that created it, with UC_CHECKED_LOCALP that is asserted.
+	/// </summary>
+	template<typename T>
+	class LocalP
+	{
+		using block_t = _Detail::LocalBlock<T>;
+		using alloc_t = _Detail::PoolAllocator<block_t>;
+
+		T* ptr;
+		block_t* block;
+
+		forceinline void check( ) const noexcept
+		{
+#if UC_CHECKED_LOCALP
+			BOOST_ASSERT_MSG( block == nullptr || block->thread == boost::this_thread::get_id( ) , "A UC::LocalP was used by a thread other than the one that created it." );
+#endif
+		}
+		forceinline void addRef( ) const noexcept { if ( block != nullptr ) { check( ); ++block->refs; } }
+		forceinline void release( ) noexcept
+		{
+			if ( block == nullptr ) return;
+			check( );
+			if ( --block->refs == 0 )
+			{
+				alloc_t alloc;
+				std::allocator_traits<alloc_t>::destroy( alloc , block );
+				alloc.deallocate( block , 1 );
+			}
+		}
+		void adopt( GCPtr<T>&& value )
+		{
+			if ( value == nullptr ) return;
+			alloc_t alloc;
+			block_t* newBlock = alloc.allocate( 1 );
+			ptr = std::addressof( *value );
+			::new( static_cast< void* >( newBlock ) ) block_t( std::move( value ) );
+			block = newBlock;
+		}
+	public:
+		using element_type = T;
+
+		forceinline LocalP( ) noexcept :ptr( nullptr ) , block( nullptr ) { }
+		forceinline LocalP( nullptr_t ) noexcept :ptr( nullptr ) , block( nullptr ) { }
+		/// <summary>
+		/// Takes a strong reference to the object in value, this is the only atomic operation of the LocalP & its copies.
+		/// </summary>
+		explicit LocalP( const GCPtr<T>& value ) :LocalP( ) { adopt( GCPtr<T>( value ) ); }
+		explicit LocalP( GCPtr<T>&& value ) :LocalP( ) { adopt( std::move( value ) ); }
+		/// <summary>
+		/// The LocalPs of different types don't share a count, so this takes a new strong reference.
+		/// </summary>
+		template<typename T2>
+		explicit LocalP( const LocalP<T2>& value ) : LocalP( ) { adopt( GCPtr<T>( value.ToGC( ) ) ); }
+
+		forceinline LocalP( const LocalP<T>& value ) noexcept :ptr( value.ptr ) , block( value.block ) { addRef( ); }
+		forceinline LocalP( LocalP<T>&& value ) noexcept :ptr( value.ptr ) , block( value.block ) { value.ptr = nullptr; value.block = nullptr; }
+		forceinline ~LocalP( ) { release( ); }
+
+		forceinline LocalP<T>& operator=( const LocalP<T>& value ) noexcept { LocalP<T>( value ).swap( *this ); return *this; }
+		forceinline LocalP<T>& operator=( LocalP<T>&& value ) noexcept { LocalP<T>( std::move( value ) ).swap( *this ); return *this; }
+		forceinline void swap( LocalP<T>& value ) noexcept { std::swap( ptr , value.ptr ); std::swap( block , value.block ); }
+		forceinline LocalP<T>& Reset( ) noexcept { LocalP<T>( ).swap( *this ); return *this; }
+
+		/// <summary>
+		/// Gets a GCPtr to the object, that can be shared with other threads.
+		/// </summary>
+		forceinline GCPtr<T> ToGC( ) const { if ( block == nullptr ) return nullptr; check( ); return block->owner; }
+		forceinline operator GCPtr<T>( ) const { return ToGC( ); }
+
+		forceinline T& operator*( ) const { if ( ptr == nullptr )throw NullPointerException( "Trying to dereference a null pointer." ); check( ); return *ptr; }
+		forceinline T* operator->( ) const { if ( ptr == nullptr )throw NullPointerException( "Trying to dereference a null pointer." ); check( ); return ptr; }
+
+		forceinline bool HasValue( ) const noexcept { return ptr != nullptr; }
+		forceinline explicit operator bool( ) const noexcept { return ptr != nullptr; }
+		forceinline bool operator==( nullptr_t ) const noexcept { return ptr == nullptr; }
+		forceinline bool operator!=( nullptr_t ) const noexcept { return ptr != nullptr; }
+		template<typename T2>
+		forceinline bool RefEq( const LocalP<T2>& value ) const noexcept { return ptr == value.ptr; }
+		template<typename T2>
+		forceinline bool RefEq( const GCPtr<T2>& value ) const noexcept { return value.HasValue( ) ? ptr == std::addressof( *value ) : ptr == nullptr; }
+		/// <summary>
+		/// Gets the number of LocalPs sharing the strong reference, 0 if null.
+		/// </summary>
+		forceinline size_t LocalCount( ) const noexcept { return block == nullptr ? 0 : block->refs; }
+
+		template<typename T2>
+		friend class LocalP;
+	};
+
 	// NatVector = Native Vector
 	template<typename T>
 	using NatVector = boost::container::vector<T>;
@@ -379,38 +1294,594 @@ namespace UC
 	// NatOVector = Native Object Vector
 	using NatOVector = NatVector<P<Object>>;
 
-	template<typename TKey , typename TVal>
-	using NatMap = boost::unordered_map<TKey , TVal , Hasher<TKey>>;
+	/// <summary>
+	/// A non-owning view of the arguments of a reflective call.
+	/// It can be created from a NatOVector or an array of P&lt;Object&gt;s without allocating anything on the heap,
+	/// the arguments must outlive the span. The calls taking an ArgSpan also take a braced list & build the span themselves.
+	/// </summary>
+	class ArgSpan
+	{
+		const P<Object>* first;
+		size_t len;
+	public:
+		constexpr ArgSpan( ) noexcept : first( nullptr ) , len( 0 ) { }
+		constexpr ArgSpan( const P<Object>* first , size_t len ) noexcept : first( first ) , len( len ) { }
+		template<size_t N>
+		constexpr ArgSpan( const P<Object>( &args )[ N ] ) noexcept : first( args ) , len( N ) { }
+		ArgSpan( const NatOVector& args ) noexcept : first( args.data( ) ) , len( args.size( ) ) { }
+
+		forceinline constexpr size_t size( ) const noexcept { return len; }
+		forceinline constexpr bool empty( ) const noexcept { return len == 0; }
+		forceinline constexpr const P<Object>* data( ) const noexcept { return first; }
+		forceinline constexpr const P<Object>* begin( ) const noexcept { return first; }
+		forceinline constexpr const P<Object>* end( ) const noexcept { return first + len; }
+		forceinline constexpr const P<Object>& operator[]( size_t i ) const noexcept { return first[ i ]; }
+	};
+
+	template<typename TKey , typename TVal>
+	using NatMap = boost::unordered_map<TKey , TVal , Hasher<TKey>>;
+
+#pragma region Cycle Collector
+	namespace _Detail
+	{
+		template<typename> struct IsGCPtr :std::false_type { };
+		template<typename T> struct IsGCPtr<P<T>> :std::true_type { using element_type = T; };
+		template<typename> struct IsStdPair :std::false_type { };
+		template<typename T1 , typename T2> struct IsStdPair<std::pair<T1 , T2>> :std::true_type { };
+		template<typename T , typename = void> struct IsIterable :std::false_type { };
+		template<typename T> struct IsIterable<T , std::void_t<decltype( std::begin( std::declval<T&>( ) ) ) , decltype( std::end( std::declval<T&>( ) ) )>> :std::true_type { };
+		template<typename T , typename = void> struct HasClear :std::false_type { };
+		template<typename T> struct HasClear<T , std::void_t<decltype( std::declval<T&>( ).clear( ) )>> :std::true_type { };
+
+		/// <summary>
+		/// Checks if a field of type T can hold a P&lt;T&gt; to a UCInterface, directly, in a pair or in a (nested) container.
+		/// </summary>
+		template<typename T>
+		constexpr bool HoldsGCEdges( )
+		{
+			using U = std::remove_cv_t<std::remove_reference_t<T>>;
+			if constexpr ( IsGCPtr<U>::value ) return std::is_base_of_v<Object , std::remove_cv_t<typename IsGCPtr<U>::element_type>>;
+			else if constexpr ( IsStdPair<U>::value ) return HoldsGCEdges<typename U::first_type>( ) || HoldsGCEdges<typename U::second_type>( );
+			else if constexpr ( IsIterable<U>::value ) return HoldsGCEdges<decltype( *std::begin( std::declval<U&>( ) ) )>( );
+			else return false;
+		}
+	}
+
+	namespace GC
+	{
+		/// <summary>
+		/// Receives the outgoing edges of an object from Object::TraceEdges.
+		/// </summary>
+		class EdgeVisitor
+		{
+		public:
+			virtual void Visit( Object* target ) = 0;
+
+			/// <summary>
+			/// Visits the UCInterfaces the field refers to, the field can be a P&lt;T&gt;, a pair or a (nested) container of them.
+			/// WeakPtrs & fields of any other type aren't edges & are ignored.
+			/// </summary>
+			template<typename T>
+			void operator()( const T& field )
+			{
+				if constexpr ( !_Detail::HoldsGCEdges<T>( ) ) return;
+				else if constexpr ( _Detail::IsGCPtr<T>::value ) { if ( field != nullptr ) Visit( const_cast< Object* >( static_cast< const Object* >( std::addressof( *field ) ) ) ); }
+				else if constexpr ( _Detail::IsStdPair<T>::value ) { ( *this )( field.first ); ( *this )( field.second ); }
+				else for ( const auto& item : field ) ( *this )( item );
+			}
+		};
+
+		/// <summary>
+		/// Drops the edges held by the field, used by the ClearEdges generated by UC_HasGCEdges.
+		/// </summary>
+		template<typename T>
+		void ClearEdge( T& field )
+		{
+			if constexpr ( std::is_const_v<T> || !_Detail::HoldsGCEdges<T>( ) ) return;
+			else if constexpr ( _Detail::IsGCPtr<T>::value ) field.Reset( );
+			else if constexpr ( _Detail::IsStdPair<T>::value ) { ClearEdge( field.first ); ClearEdge( field.second ); }
+			else if constexpr ( _Detail::HasClear<T>::value ) field.clear( );
+			else for ( auto& item : field ) ClearEdge( item );
+		}
+
+		/// <summary>
+		/// The result of GC::CollectFor.
+		/// </summary>
+		struct CollectStats
+		{
+			// The number of objects whose references were examined.
+			size_t Examined = 0;
+			// The number of objects freed.
+			size_t Freed = 0;
+			// If every tracked object was examined, the next call will start over.
+			bool Finished = false;
+		};
+
+		/// <summary>
+		/// Enables (or disables) the registration of newly created objects whose UCInterfaces are UC_HasGCEdges with the cycle collector, it is disabled by default.
+		/// Objects created while it is disabled are never collected.
+		/// </summary>
+		forceinline void Enable( bool enable = true ) noexcept { _Detail::cycleCollectorEnabled.store( enable , std::memory_order_relaxed ); }
+		forceinline bool IsEnabled( ) noexcept { return _Detail::cycleCollectorEnabled.load( std::memory_order_relaxed ); }
+		/// <summary>
+		/// Gets the number of live objects registered with the cycle collector.
+		/// </summary>
+		size_t TrackedCount( );
+		/// <summary>
+		/// Frees every garbage cycle of the registered objects & returns the number of objects freed.
+		/// The object graph of the registered objects must not be modified by other threads while collecting.
+		/// </summary>
+		size_t Collect( );
+		/// <summary>
+		/// Collects incrementally, examining the registered objects from where the last call left off until the budget runs out.
+		/// The object graph of the registered objects must not be modified by other threads while collecting.
+		/// </summary>
+		CollectStats CollectFor( std::chrono::microseconds budget );
+	}
+#pragma endregion
+
+
+#pragma region Selectors
+	namespace _Detail
+	{
+		struct SelectorInfo
+		{
+			NatString name;
+			uint64_t hash;
+			uint32_t id;
+		};
+
+		struct MethodRef;
+		class MethodTable;
+		class BatchResolver;
+	}
+	class CallSiteCache;
+	class TypeHandle;
+
+	/// <summary>
+	/// An interned method name. Interning the same name always gives the same Selector and every Selector has a dense integer ID.
+	/// Reflective calls made through a Selector never touch the characters of the name.
+	/// </summary>
+	class Selector
+	{
+		const _Detail::SelectorInfo* info;
+
+		explicit Selector( const _Detail::SelectorInfo* info ) noexcept :info( info ) { }
+	public:
+		using id_t = uint32_t;
+
+		explicit Selector( std::string_view name ) :Selector( Intern( name ) ) { }
+
+		static Selector Intern( std::string_view name );
+		/// <summary>
+		/// Gets the Selector of name if it has already been interned, without interning it.
+		/// </summary>
+		static std::optional<Selector> Find( std::string_view name );
+		static size_t Count( );
+
+		forceinline id_t Id( ) const noexcept { return info->id; }
+		forceinline const NatString& Name( ) const noexcept { return info->name; }
+		forceinline uint64_t Hash( ) const noexcept { return info->hash; }
+
+		forceinline bool operator==( const Selector& o ) const noexcept { return info == o.info; }
+		forceinline bool operator!=( const Selector& o ) const noexcept { return info != o.info; }
+
+		friend struct _Detail::MethodRef;
+		friend class _Detail::MethodTable;
+		friend class CallSiteCache;
+	};
+#pragma endregion
+
+#pragma region Method Dispatch Tables
+	namespace _Detail
+	{
+		/// <summary>
+		/// FNV-1a hash of a method name, the names declared in <seealso cref="UC_HasMethods"/> are hashed once when the table is built.
+		/// </summary>
+		constexpr uint64_t HashMethodName( const char* name , size_t len ) noexcept
+		{
+			uint64_t hash = 0xcbf29ce484222325ULL;
+			for ( size_t i = 0; i < len; i++ )
+			{
+				hash ^= static_cast< uint8_t >( name[ i ] );
+				hash *= 0x100000001b3ULL;
+			}
+			return hash;
+		}
+
+		constexpr uint64_t MakeMethodKey( uint64_t nameHash , size_t arity ) noexcept
+		{ return nameHash ^ ( ( arity + 1 ) * 0x9e3779b97f4a7c15ULL ); }
+
+		/// <summary>
+		/// The name of the method being looked up by a reflective Call, it is hashed once and passed up the inheritance chain.
+		/// </summary>
+		struct MethodRef
+		{
+			const NatString& name;
+			const uint64_t hash;
+			const SelectorInfo* const selector;
+
+			explicit MethodRef( const NatString& name ) noexcept :
+				name( name ) , hash( HashMethodName( name.data( ) , name.size( ) ) ) , selector( nullptr ) { }
+			explicit MethodRef( Selector sel ) noexcept :name( sel.info->name ) , hash( sel.info->hash ) , selector( sel.info ) { }
+		};
+
+		/// <summary>
+		/// A unique address for every native return type, used to match the return type of a typed method with the type asked for by CallAs.
+		/// </summary>
+		template<typename T> struct ReturnTagHolder { static constexpr char tag = 0; };
+		template<typename T> constexpr const void* ReturnTag( ) noexcept { return &ReturnTagHolder<T>::tag; }
+
+		template<typename R> R Unbox( const P<Object>& v );
+		template<typename R> R Unbox( P<Object>&& v );
+
+		struct MethodEntry
+		{
+			using thunk_t = P<Object>( *)( Object& me , ArgSpan args );
+			using typed_thunk_t = void( *)( Object& me , ArgSpan args , void* result );
+
+			uint64_t key;
+			const char* name;
+			size_t nameLen;
+			size_t arity;
+			thunk_t thunk;
+			const SelectorInfo* selector;
+			// Only set for the methods that declare a native return type, typedThunk writes the unboxed result to a returnType*.
+			typed_thunk_t typedThunk;
+			const void* returnType;
+
+			constexpr MethodEntry( ) noexcept :
+				key( 0 ) , name( nullptr ) , nameLen( 0 ) , arity( 0 ) , thunk( nullptr ) , selector( nullptr ) , typedThunk( nullptr ) , returnType( nullptr ) { }
+			template<size_t N>
+			constexpr MethodEntry( const char( &name )[ N ] , size_t arity , thunk_t thunk , typed_thunk_t typedThunk = nullptr , const void* returnType = nullptr ) noexcept :
+				key( MakeMethodKey( HashMethodName( name , N - 1 ) , arity ) ) , name( name ) , nameLen( N - 1 ) , arity( arity ) , thunk( thunk ) ,
+				selector( nullptr ) , typedThunk( typedThunk ) , returnType( returnType ) { }
+		};
+
+		/// <summary>
+		/// Per-UCInterface open addressing hash table of the methods declared in <seealso cref="UC_HasMethods"/>, keyed on (name hash, arity).
+		/// </summary>
+		class MethodTable
+		{
+			NatVector<MethodEntry> slots;
+			size_t mask;
+		public:
+			MethodTable( std::initializer_list<MethodEntry> entries );
+
+			const MethodEntry* Find( const MethodRef& method , size_t arity ) const noexcept
+			{
+				const auto key = MakeMethodKey( method.hash , arity );
+				for ( size_t i = key & mask;; i = ( i + 1 ) & mask )
+				{
+					const auto& slot = slots[ i ];
+					if ( slot.thunk == nullptr ) return nullptr;
+					if ( slot.key != key || slot.arity != arity ) continue;
+					if ( method.selector != nullptr ) { if ( slot.selector == method.selector ) return &slot; }
+					else if ( slot.nameLen == method.name.size( ) &&
+							  std::char_traits<char>::compare( slot.name , method.name.data( ) , slot.nameLen ) == 0 )
+						return &slot;
+				}
+			}
+		};
+	}
+#pragma endregion
+
+#pragma region Type Information
+	/// <summary>
+	/// Tags the boxed primitive <seealso cref="UCInterface"/>s, so that the numeric conversion functions need a single switch instead of a chain of casts.
+	/// </summary>
+	enum class NumKind : uint8_t
+	{
+		None , Int16 , Int32 , Int64 , UInt16 , UInt32 , UInt64 , Float , Double , Byte , SByte , Bool
+	};
+
+	/// <summary>
+	/// The runtime type information of a <seealso cref="UCInterface"/>.
+	/// Every UCInterface gets a dense integer ID, bases always get smaller IDs than the types deriving from them,
+	/// and the set of the IDs of all of its ancestors (including itself), so that an "is a" check is a single bit test.
+	/// </summary>
+	class TypeInfo
+	{
+		uint32_t id;
+		const NatString& name;
+		boost::dynamic_bitset<> ancestors;
+	public:
+		using id_t = uint32_t;
+
+		TypeInfo( const NatString& name , std::initializer_list<const TypeInfo*> bases );
+		TypeInfo( const TypeInfo& ) = delete;
+		TypeInfo& operator=( const TypeInfo& ) = delete;
+
+		forceinline id_t Id( ) const noexcept { return id; }
+		forceinline const NatString& Name( ) const noexcept { return name; }
+		/// <summary>
+		/// Checks whether the type with the ID typeId is this type or one of its ancestors.
+		/// </summary>
+		forceinline bool IsA( id_t typeId ) const noexcept { return typeId < ancestors.size( ) && ancestors.test( typeId ); }
+		forceinline bool IsA( const TypeInfo& type ) const noexcept { return IsA( type.id ); }
+
+		/// <summary>
+		/// Gets the number of type IDs assigned so far.
+		/// </summary>
+		static size_t Count( ) noexcept;
+	};
+#pragma endregion
+
+
+#pragma region Type Statistics
+	/// <summary>
+	/// The live objects of a single UCInterface, given by TypeStats::Snapshot.
+	/// </summary>
+	struct TypeStatsEntry
+	{
+		NatString Name;
+		// The number of objects alive.
+		int64_t Live = 0;
+		// The number of objects made since TypeStats were enabled.
+		uint64_t TotalAllocated = 0;
+		// sizeof the UCInterface, the memory it holds outside of the object (e.g. the characters of a long String) isn't included.
+		size_t ObjectSize = 0;
+		// Live * ObjectSize.
+		uint64_t Bytes = 0;
+	};
+
+	/// <summary>
+	/// Counts the objects made by the generated factories (Make, MakeWith & make_reflective) for every UCInterface.
+	/// It is disabled by default, which only costs a single relaxed load for every object made.
+	/// The objects made while it is disabled aren't counted even after it is enabled.
+	/// </summary>
+	class TypeStats
+	{
+	public:
+		static forceinline void Enable( bool enable = true ) noexcept { _Detail::typeStatsEnabled.store( enable , std::memory_order_relaxed ); }
+		static forceinline bool IsEnabled( ) noexcept { return _Detail::typeStatsEnabled.load( std::memory_order_relaxed ); }
+		/// <summary>
+		/// Gets the counts of every UCInterface that had an object made since TypeStats were enabled, the ones with the most live bytes first.
+		/// </summary>
+		static NatVector<TypeStatsEntry> Snapshot( );
+		/// <summary>
+		/// Gets the counts of the UCInterface with the type-name typeName, all of them are 0 if it didn't have an object made.
+		/// </summary>
+		static TypeStatsEntry Get( std::string_view typeName );
+		/// <summary>
+		/// Writes the Snapshot to out, one type per line, only the first top types if top isn't 0.
+		/// </summary>
+		static void Dump( std::ostream& out , size_t top = 0 );
+		/// <summary>
+		/// Dumps to out every interval on a background thread, until StopPeriodicDump is called.
+		/// out must outlive the periodic dump.
+		/// </summary>
+		static void StartPeriodicDump( std::chrono::milliseconds interval , std::ostream& out = std::cerr , size_t top = 0 );
+		static void StopPeriodicDump( );
+	};
+#pragma endregion
+
+	/// <summary>
+	/// This is the base class of all <seealso cref="UCInterface"/>s.
+	/// It is the root of the UC++ type hierarchy.
+	/// </summary>
+	/// <seealso cref="EnableGCPtrFromMe{Object}" />
+#ifdef UC_INTRUSIVE_GCPTR
+	class Object : public _Detail::RefCounted , public EnableGCPtrFromMe<Object>
+#else
+	class Object : public EnableGCPtrFromMe<Object>
+#endif
+	{
+	public:
+		using CtorT = P<Object>( *)( ArgSpan args );
+		virtual ~Object( );
+
+		static const NatString& SGetTypeName( ) { static NatString s = "UC::Object"; return s; }
+		virtual const NatString& GetTypeName( ) const { return SGetTypeName( ); };
+		static const TypeInfo& SGetTypeInfo( ) { static const TypeInfo info( SGetTypeName( ) , { } ); return info; }
+		virtual const TypeInfo& GetTypeInfo( ) const { return SGetTypeInfo( ); }
+		/// <summary>
+		/// Gets the dense integer ID of the dynamic type of the object.
+		/// </summary>
+		forceinline TypeInfo::id_t TypeId( ) const { return GetTypeInfo( ).Id( ); }
+		/// <summary>
+		/// Gets the kind of the boxed primitive, NumKind::None for every other type.
+		/// </summary>
+		virtual NumKind GetNumKind( ) const { return NumKind::None; }
+		forceinline P<Object> Call( const NatString& fname , ArgSpan args ) { return callImpl( _Detail::MethodRef( fname ) , args ); }
+		forceinline P<Object> Call( Selector fname , ArgSpan args ) { return callImpl( _Detail::MethodRef( fname ) , args ); }
+		forceinline P<Object> Call( const NatString& fname , std::initializer_list<P<Object>> args ) { return Call( fname , ArgSpan( args.begin( ) , args.size( ) ) ); }
+		forceinline P<Object> Call( Selector fname , std::initializer_list<P<Object>> args ) { return Call( fname , ArgSpan( args.begin( ) , args.size( ) ) ); }
+		/// <summary>
+		/// Calls the method like Call does, but returns false instead of throwing a NoSuchFunction_Exception if there is no such method.
+		/// </summary>
+		forceinline bool TryCall( const NatString& fname , ArgSpan args , P<Object>& result ) { return tryCallImpl( _Detail::MethodRef( fname ) , args , result ); }
+		forceinline bool TryCall( Selector fname , ArgSpan args , P<Object>& result ) { return tryCallImpl( _Detail::MethodRef( fname ) , args , result ); }
+		forceinline bool TryCall( const NatString& fname , std::initializer_list<P<Object>> args , P<Object>& result ) { return TryCall( fname , ArgSpan( args.begin( ) , args.size( ) ) , result ); }
+		forceinline bool TryCall( Selector fname , std::initializer_list<P<Object>> args , P<Object>& result ) { return TryCall( fname , ArgSpan( args.begin( ) , args.size( ) ) , result ); }
+		/// <summary>
+		/// Calls the method like Call does, but returns the result as the native type R.
+		/// If the method declares R as its native return type in <seealso cref="UC_HasMethods"/> the result is never boxed,
+		/// otherwise the boxed result is converted like UCAsInt64, UCAsDouble, etc. or UCCast do.
+		/// R must be default constructible.
+		/// </summary>
+		template<typename R> forceinline R CallAs( const NatString& fname , ArgSpan args ) { return callAsImpl<R>( _Detail::MethodRef( fname ) , args ); }
+		template<typename R> forceinline R CallAs( Selector fname , ArgSpan args ) { return callAsImpl<R>( _Detail::MethodRef( fname ) , args ); }
+		template<typename R> forceinline R CallAs( const NatString& fname , std::initializer_list<P<Object>> args ) { return CallAs<R>( fname , ArgSpan( args.begin( ) , args.size( ) ) ); }
+		template<typename R> forceinline R CallAs( Selector fname , std::initializer_list<P<Object>> args ) { return CallAs<R>( fname , ArgSpan( args.begin( ) , args.size( ) ) ); }
+		virtual NatString ToString( ) const;
+		virtual int64_t GetHashCode( ) const;
+		/// <summary>
+		/// Visits the outgoing edges of the object for the cycle collector, generated by <seealso cref="UC_HasGCEdges"/>.
+		/// </summary>
+		virtual void TraceEdges( GC::EdgeVisitor& ) const { }
+		/// <summary>
+		/// Drops the outgoing edges of the object, called by the cycle collector on the objects of a garbage cycle before freeing them.
+		/// </summary>
+		virtual void ClearEdges( ) { }
+
+		Object( Object&& ) = delete;
+		Object& operator=( Object&& ) = delete;
+
+		static P<Object> CreateInstance( std::string_view className , ArgSpan args );
+		static P<Object> CreateInstance( std::string_view className , std::initializer_list<P<Object>> args ) { return CreateInstance( className , ArgSpan( args.begin( ) , args.size( ) ) ); }
+		/// <summary>
+		/// Looks up the registered type with the name className once, the TypeHandle can be kept to create instances of it without any lookups.
+		/// Throws a NoSuchRegisteredType_Exception if there is no such registered type.
+		/// </summary>
+		static TypeHandle ResolveType( std::string_view className );
+
+		static void addConstructor( const NatString& className , CtorT ctor );
+
+		using EGCPFM = EnableGCPtrFromMe<Object>;
+	protected:
+		Object( );
+		forceinline static const _Detail::MethodEntry* resolveImpl( const _Detail::MethodRef& , size_t ) { return nullptr; }
+		virtual const _Detail::MethodEntry* resolveDispatch( const _Detail::MethodRef& fname , size_t argsLen ) const = 0;
+	private:
+		P<Object> callImpl( const _Detail::MethodRef& fname , ArgSpan args )
+		{
+			if ( auto method = resolveDispatch( fname , args.size( ) ) ) return method->thunk( *this , args );
+			throwNoSuchFunction( fname , args.size( ) );
+		}
+		template<typename R>
+		R callAsImpl( const _Detail::MethodRef& fname , ArgSpan args )
+		{
+			auto method = resolveDispatch( fname , args.size( ) );
+			if ( method == nullptr ) throwNoSuchFunction( fname , args.size( ) );
+			if ( method->returnType == _Detail::ReturnTag<R>( ) )
+			{
+				R result { };
+				method->typedThunk( *this , args , &result );
+				return result;
+			}
+			return _Detail::Unbox<R>( method->thunk( *this , args ) );
+		}
+		bool tryCallImpl( const _Detail::MethodRef& fname , ArgSpan args , P<Object>& result )
+		{
+			auto method = resolveDispatch( fname , args.size( ) );
+			if ( method == nullptr ) return false;
+			result = method->thunk( *this , args );
+			return true;
+		}
+		[[noreturn]] void throwNoSuchFunction( const _Detail::MethodRef& fname , size_t argsLen ) const;
+
+		friend class CallSiteCache;
+		friend class _Detail::BatchResolver;
+	};
+
+	/// <summary>
+	/// A pre-resolved registered type, given by Object::ResolveType.
+	/// </summary>
+	class TypeHandle
+	{
+		const NatString* name;
+		Object::CtorT ctor;
+
+		TypeHandle( const NatString* name , Object::CtorT ctor ) noexcept :name( name ) , ctor( ctor ) { }
+		friend class Object;
+	public:
+		constexpr TypeHandle( ) noexcept :name( nullptr ) , ctor( nullptr ) { }
+
+		forceinline P<Object> CreateInstance( ArgSpan args ) const { return ctor( args ); }
+		forceinline P<Object> CreateInstance( std::initializer_list<P<Object>> args ) const { return ctor( ArgSpan( args.begin( ) , args.size( ) ) ); }
+		forceinline const NatString& Name( ) const noexcept { return *name; }
+		forceinline explicit operator bool( ) const noexcept { return ctor != nullptr; }
+		forceinline bool operator==( const TypeHandle& o ) const noexcept { return ctor == o.ctor; }
+		forceinline bool operator!=( const TypeHandle& o ) const noexcept { return ctor != o.ctor; }
+	};
 
+#pragma region Call Site Caches
 	/// <summary>
-	/// This is the base class of all <seealso cref="UCInterface"/>s.
-	/// It is the root of the UC++ type hierarchy.
+	/// A polymorphic inline cache for a single reflective call site.
+	/// It remembers the methods resolved for the last few (type, name, number of arguments) combinations seen and calls them directly,
+	/// falling back to the full resolution of Call on a miss. UCC & UCCS use a thread local CallSiteCache for every call site.
 	/// </summary>
-	/// <seealso cref="EnableGCPtrFromMe{Object}" />
-	class Object : public EnableGCPtrFromMe<Object>
+	class CallSiteCache
 	{
 	public:
-		using CtorT = P<Object>( *)( const NatOVector& args );
-		virtual ~Object( );
+		static constexpr size_t Capacity = 4;
 
-		static const NatString& SGetTypeName( ) { static NatString s = "UC::Object"; return s; }
-		virtual const NatString& GetTypeName( ) const { return SGetTypeName( ); };
-		virtual P<Object> Call( const NatString& fname , const NatOVector& args ) = 0;
-		virtual NatString ToString( ) const;
-		virtual int64_t GetHashCode( ) const;
+		template<typename TPtr>
+		forceinline P<Object> Call( TPtr&& var , const NatString& fname , ArgSpan args )
+		{
+			// A NatString can be changed in place, so it is compared by content with the last name.
+			if ( lastSelector == nullptr || lastSelector->name != fname ) findSelector( nullptr , fname );
+			if ( lastSelector == nullptr ) return missNamed( *var , fname , args );
+			return callImpl( *var , lastSelector , args );
+		}
+		template<typename TPtr>
+		forceinline P<Object> Call( TPtr&& var , const char* fname , ArgSpan args )
+		{
+			// The name at the same address is usually the same string literal, but a buffer may have been changed since, so it is still compared.
+			// strncmp stops at the end of the shorter name, so it never reads past the end of fname.
+			if ( fname != lastName ||
+				 ( lastSelector != nullptr && std::strncmp( lastSelector->name.c_str( ) , fname , lastSelector->name.size( ) + 1 ) != 0 ) )
+				findSelector( fname , fname );
+			if ( lastSelector == nullptr ) return missNamed( *var , fname , args );
+			return callImpl( *var , lastSelector , args );
+		}
+		template<typename TPtr>
+		forceinline P<Object> Call( TPtr&& var , Selector fname , ArgSpan args )
+		{ return callImpl( *var , fname.info , args ); }
+		template<typename TPtr>
+		forceinline P<Object> Call( TPtr&& var , const NatString& fname , std::initializer_list<P<Object>> args )
+		{ return Call( std::forward<TPtr>( var ) , fname , ArgSpan( args.begin( ) , args.size( ) ) ); }
+		template<typename TPtr>
+		forceinline P<Object> Call( TPtr&& var , const char* fname , std::initializer_list<P<Object>> args )
+		{ return Call( std::forward<TPtr>( var ) , fname , ArgSpan( args.begin( ) , args.size( ) ) ); }
+		template<typename TPtr>
+		forceinline P<Object> Call( TPtr&& var , Selector fname , std::initializer_list<P<Object>> args )
+		{ return Call( std::forward<TPtr>( var ) , fname , ArgSpan( args.begin( ) , args.size( ) ) ); }
+
+		forceinline uint64_t Hits( ) const noexcept { return hits; }
+		forceinline uint64_t Misses( ) const noexcept { return misses; }
+		void Clear( ) noexcept;
+
+		/// <summary>
+		/// Enables or disables counting the hits & misses of all call sites in all threads, it is disabled by default.
+		/// </summary>
+		static void EnableTotals( bool enable ) noexcept { totalsEnabled.store( enable , std::memory_order_relaxed ); }
+		static uint64_t TotalHits( ) noexcept { return totalHits.load( std::memory_order_relaxed ); }
+		static uint64_t TotalMisses( ) noexcept { return totalMisses.load( std::memory_order_relaxed ); }
+		static void ResetTotals( ) noexcept;
+	private:
+		struct Entry
+		{
+			const NatString* type;
+			const _Detail::SelectorInfo* selector;
+			size_t arity;
+			const _Detail::MethodEntry* method;
+		};
 
-		Object( Object&& ) = delete;
-		Object& operator=( Object&& ) = delete;
+		Entry entries[ Capacity ] { };
+		size_t next = 0;
+		// The Selector of the last name, lastName is only set when the last name was given as a const char*.
+		const char* lastName = nullptr;
+		const _Detail::SelectorInfo* lastSelector = nullptr;
+		uint64_t hits = 0 , misses = 0;
 
-		static P<Object> CreateInstance( const NatString& className , const NatOVector& args );
+		inline static std::atomic<bool> totalsEnabled { false };
+		inline static std::atomic<uint64_t> totalHits { 0 } , totalMisses { 0 };
 
-		static void addConstructor( const NatString& className , CtorT ctor );
+		/// <summary>
+		/// Looks up the Selector of a name that changed, the name isn't interned unless a method with it is found by missNamed.
+		/// </summary>
+		void findSelector( const char* address , std::string_view fname );
 
-		using EGCPFM = EnableGCPtrFromMe<Object>;
-	protected:
-		Object( );
-		forceinline P<Object> callImpl( const NatString& fname , const NatOVector& args ) { return nullptr; }
+		forceinline P<Object> callImpl( Object& obj , const _Detail::SelectorInfo* selector , ArgSpan args )
+		{
+			const auto type = &obj.GetTypeName( );
+			const auto arity = args.size( );
+			for ( const auto& entry : entries )
+				if ( entry.type == type && entry.selector == selector && entry.arity == arity )
+				{
+					++hits;
+					if ( totalsEnabled.load( std::memory_order_relaxed ) ) totalHits.fetch_add( 1 , std::memory_order_relaxed );
+					return entry.method->thunk( obj , args );
+				}
+			return miss( obj , selector , args );
+		}
+
+		P<Object> miss( Object& obj , const _Detail::SelectorInfo* selector , ArgSpan args );
+		P<Object> missNamed( Object& obj , std::string_view fname , ArgSpan args );
 	};
+#pragma endregion
 
 #pragma region Casting & Checking
 	/// <summary>
@@ -418,7 +1889,51 @@ namespace UC
 	/// </summary>
 	/// <param name="v">The value.</param>
 	/// <returns></returns>
-	template<typename T , typename T2>forceinline P<T> ObjCast( const P<T2>& v ) { return std::dynamic_pointer_cast< T >( v.ptr ); }
+	namespace _Detail
+	{
+		template<typename T , typename T2>
+		using StaticCastT = decltype( static_cast< T* >( std::declval<T2*>( ) ) );
+		template<typename T>
+		using SelfT = typename T::self;
+
+		/// <summary>
+		/// Checks whether T declares its own TypeInfo, a plain C++ subclass of a UCInterface inherits the TypeInfo of its base,
+		/// so the type ID check can't tell it apart from its base.
+		/// </summary>
+		template<typename T> constexpr bool DeclaresTypeInfo( )
+		{
+			using U = std::remove_cv_t<T>;
+			if constexpr ( std::is_same_v<U , Object> ) return true;
+			else if constexpr ( boost::is_detected_v<SelfT , U> ) return std::is_same_v<SelfT<U> , U>;
+			else return false;
+		}
+	}
+
+	template<typename T , typename T2>forceinline P<T> ObjCast( const P<T2>& v )
+	{
+		if constexpr ( std::is_base_of_v<Object , T> && std::is_base_of_v<Object , T2> && _Detail::DeclaresTypeInfo<T>( ) )
+		{
+			// The check is a bit test on the type IDs, dynamic_cast is only needed when a static_cast can't adjust the pointer.
+			if ( v.ptr == nullptr || !v.ptr->GetTypeInfo( ).IsA( T::SGetTypeInfo( ) ) ) return nullptr;
+			if constexpr ( boost::is_detected_v<_Detail::StaticCastT , T , T2> ) return _Detail::StaticPtrCast<T>( v );
+			else return _Detail::DynamicPtrCast<T>( v );
+		}
+		else return _Detail::DynamicPtrCast<T>( v );
+	}
+
+	/// <summary>
+	/// Casts v, taking over its reference if the cast succeeds, v is left untouched if it doesn't.
+	/// </summary>
+	template<typename T , typename T2>forceinline P<T> ObjCast( P<T2>&& v )
+	{
+		if constexpr ( std::is_base_of_v<Object , T> && std::is_base_of_v<Object , T2> && _Detail::DeclaresTypeInfo<T>( ) )
+		{
+			if ( v.ptr == nullptr || !v.ptr->GetTypeInfo( ).IsA( T::SGetTypeInfo( ) ) ) return nullptr;
+			if constexpr ( boost::is_detected_v<_Detail::StaticCastT , T , T2> ) return _Detail::StaticPtrCast<T>( std::move( v ) );
+			else return _Detail::DynamicPtrCast<T>( std::move( v ) );
+		}
+		else return _Detail::DynamicPtrCast<T>( std::move( v ) );
+	}
 
 	template<typename T , typename T2>
 	P<T> ObjCastThrowing( const P<T2>& v , const char* msg )
@@ -428,6 +1943,14 @@ namespace UC
 		return ret;
 	}
 
+	template<typename T , typename T2>
+	P<T> ObjCastThrowing( P<T2>&& v , const char* msg )
+	{
+		auto ret = ObjCast<T>( std::move( v ) );
+		if ( ret == nullptr )throw InvalidCastException( msg );
+		return ret;
+	}
+
 	template<typename T , typename T2>
 	P<T> ObjCastThrowingNatStr( const P<T2>& v , const NatString& msg )
 	{
@@ -436,37 +1959,110 @@ namespace UC
 		return ret;
 	}
 
+	template<typename T , typename T2>
+	P<T> ObjCastThrowingNatStr( P<T2>&& v , const NatString& msg )
+	{
+		auto ret = ObjCast<T>( std::move( v ) );
+		if ( ret == nullptr )throw InvalidCastException( msg );
+		return ret;
+	}
+
 	template<typename T>
-	P<T> asNotNull( const P<T>& v , const char* msg )
+	NotNull<P<T>> asNotNull( const P<T>& v , const char* msg )
 	{
 		if ( v == nullptr )throw PreNullPointerException( msg );
-		return v;
+		return NotNull<P<T>>::Unchecked( v );
 	}
 
 	template<typename T>
-	P<T> asNotNull( P<T>&& v , const char* msg )
+	NotNull<P<T>> asNotNull( P<T>&& v , const char* msg )
 	{
 		if ( v == nullptr )throw PreNullPointerException( msg );
-		return std::move( v );
+		return NotNull<P<T>>::Unchecked( std::move( v ) );
+	}
+#pragma endregion
+
+
+#pragma region Boxed Value Caches
+	namespace _Detail
+	{
+		// The arithmetic type of T, UC::byte & UC::sbyte are enums.
+		template<typename T , bool = std::is_enum_v<T>> struct ArithmeticOf { using type = T; };
+		template<typename T> struct ArithmeticOf<T , true> { using type = std::underlying_type_t<T>; };
+
+		/// <summary>
+		/// The shared boxes for the values in [UC_BOX_CACHE_MIN, UC_BOX_CACHE_MAX] that fit in T::int_t.
+		/// The boxes are immutable, so Make can hand out the same box for the same value.
+		/// </summary>
+		template<typename T>
+		class BoxCache
+		{
+			using int_t = typename T::int_t;
+			using num_t = typename ArithmeticOf<int_t>::type;
+			static constexpr int64_t first = std::numeric_limits<num_t>::is_signed ?
+				std::max<int64_t>( UC_BOX_CACHE_MIN , int64_t( std::numeric_limits<num_t>::min( ) ) ) : std::max<int64_t>( UC_BOX_CACHE_MIN , 0 );
+			static constexpr int64_t last = uint64_t( std::numeric_limits<num_t>::max( ) ) < uint64_t( UC_BOX_CACHE_MAX ) ?
+				int64_t( std::numeric_limits<num_t>::max( ) ) : int64_t( UC_BOX_CACHE_MAX );
+			static constexpr size_t count = size_t( last - first + 1 );
+
+			GCPtr<T> boxes[ count ];
+
+			BoxCache( )
+			{
+				for ( size_t i = 0; i < count; i++ )
+					boxes[ i ] = MakeGC<T>( static_cast< int_t >( static_cast< num_t >( first + int64_t( i ) ) ) );
+			}
+		public:
+			static forceinline bool Contains( int_t value ) noexcept
+			{
+				const auto num = static_cast< num_t >( value );
+				if constexpr ( std::numeric_limits<num_t>::is_signed ) return first <= int64_t( num ) && int64_t( num ) <= last;
+				else return uint64_t( num ) <= uint64_t( last ) && uint64_t( first ) <= uint64_t( num );
+			}
+			static forceinline const GCPtr<T>& Get( int_t value )
+			{
+				static const BoxCache cache;
+				return cache.boxes[ size_t( int64_t( static_cast< num_t >( value ) ) - first ) ];
+			}
+			/// <summary>
+			/// Gets the cached box for value if there is one or makes a new box.
+			/// </summary>
+			static forceinline NotNull<GCPtr<T>> Make( int_t value )
+			{
+				if ( Contains( value ) ) return NotNull<GCPtr<T>>::Unchecked( Get( value ) );
+				return MakeGC<T>( value );
+			}
+		};
 	}
 #pragma endregion
 
 
 #pragma region Integral Placeholder Interfaces
+// Like UC_OnlyHasEmptyCtor, but Make( ) and reflective construction return the cached box made by makeEmpty.
+#define __UCDefineBoxMakers(makeEmpty)\
+	static NotNull<P<self>> Make( ) { makeEmpty; }\
+	__UCDefineMakeWith\
+	static P<Object> make_reflective( ArgSpan args ){\
+		if ( args.size( ) == 0 ) return Make( );\
+		throw NoSuchConstructor_Exception( ConcatNatStrings( "No constructor for type \"" , SGetTypeName( ) , "\" that takes in " , std::to_string( args.size( ) ) , " parameters." ) );\
+	}
+
 #define __DEFINE_integralPlaceHolderInterfaces(name, underlyingType)\
 UCInterface( name , UC_WhereTypenameIs( "UC::" __ToString(name) ) , UC_InheritsUCClasses( Object ) , UC_InheritsNoNativeClasses );\
-	UC_OnlyHasEmptyCtor;\
+	__UCDefineBoxMakers( return Make( int_t{ } ) );\
 	UC_HasNoMethods;\
+	UC_IsPooled;\
 public:\
 	using int_t = underlyingType;\
 	const int_t value;\
 	forceinline name():value{ }{}\
+	virtual NumKind GetNumKind( ) const override{return NumKind::name;}\
 	bool operator==( const self& o ) const{return value == o.value;}\
 	bool operator!=( const self& o ) const{return value != o.value;}\
 	virtual NatString ToString( ) const{return std::to_string(value);}\
 	virtual int64_t GetHashCode( ) const{return Hash(value);}\
 	forceinline name(int_t value):value{value }{}\
-	forceinline static P<name> Make( int_t value ) { return P<name>( new name(value) ); }\
+	forceinline static NotNull<P<name>> Make( int_t value ) { return _Detail::BoxCache<name>::Make( value ); }\
 UCEndInterface
 
 	__DEFINE_integralPlaceHolderInterfaces( Int16 , int16_t );
@@ -484,8 +2080,9 @@ UCEndInterface
 #pragma region Floating Point Number Placeholder Interfaces
 #define __DEFINE_floatingPointPlaceHolderInterfaces(name, underlyingType, default_)\
 UCInterface( name , UC_WhereTypenameIs( "UC::" __ToString(name) ) , UC_InheritsUCClasses( Object ) , UC_InheritsNoNativeClasses );\
-	UC_OnlyHasEmptyCtor;\
+	__UCDefineBoxMakers( static const NotNull<P<name>> zero = _Detail::MakeGC<name>( ); return zero );\
 	UC_HasNoMethods;\
+	UC_IsPooled;\
 public:\
 	const underlyingType value;\
 	bool operator==( const self& o ) const{return value == o.value;}\
@@ -493,7 +2090,8 @@ public:\
 	virtual NatString ToString( ) const{return std::to_string(value);}\
 	virtual int64_t GetHashCode( ) const{return Hash(value);}\
 	forceinline name(underlyingType value=default_):value{value }{}\
-	forceinline static P<name> Make( underlyingType value ) { return P<name>( new name(value) ); }\
+	virtual NumKind GetNumKind( ) const override{return NumKind::name;}\
+	forceinline static NotNull<P<name>> Make( underlyingType value ) { return _Detail::MakeGC<name>( value ); }\
 UCEndInterface
 
 
@@ -507,17 +2105,20 @@ UCEndInterface
 #pragma region byte and sbyte Placeholder Interfaces
 #define __DEFINE_byteTypePlaceHolderInterfaces(name, underlyingType)\
 UCInterface( name , UC_WhereTypenameIs( "UC::" __ToString(name) ) , UC_InheritsUCClasses( Object ) , UC_InheritsNoNativeClasses );\
-	UC_OnlyHasEmptyCtor;\
+	__UCDefineBoxMakers( return Make( int_t{ } ) );\
 	UC_HasNoMethods;\
+	UC_IsPooled;\
 public:\
-	const underlyingType value;\
+	using int_t = underlyingType;\
+	const int_t value;\
 	bool operator==( const self& o ) const{return value == o.value;}\
 	bool operator!=( const self& o ) const{return value != o.value;}\
 	forceinline name():value{}{}\
+	virtual NumKind GetNumKind( ) const override{return NumKind::name;}\
 	virtual NatString ToString( ) const{return std::to_string(value);}\
 	virtual int64_t GetHashCode( ) const{return Hash(value);}\
 	forceinline name(underlyingType value):value{value }{}\
-	forceinline static P<name> Make( underlyingType value ) { return P<name>( new name(value) ); }\
+	forceinline static NotNull<P<name>> Make( int_t value ) { return _Detail::BoxCache<name>::Make( value ); }\
 UCEndInterface
 
 	__DEFINE_byteTypePlaceHolderInterfaces( Byte , byte );
@@ -525,6 +2126,28 @@ UCEndInterface
 	__DEFINE_byteTypePlaceHolderInterfaces( Bool , bool );
 
 #undef __DEFINE_byteTypePlaceHolderInterfaces  
+#undef __UCDefineBoxMakers
+#pragma endregion
+
+
+#pragma region Boxing
+	namespace _Detail
+	{
+	#define __DEFINE_Box(name, underlyingType) forceinline P<Object> Box( underlyingType v ) { return name::Make( v ); }
+		__DEFINE_Box( Int16 , int16_t );
+		__DEFINE_Box( Int32 , int32_t );
+		__DEFINE_Box( Int64 , int64_t );
+		__DEFINE_Box( UInt16 , uint16_t );
+		__DEFINE_Box( UInt32 , uint32_t );
+		__DEFINE_Box( UInt64 , uint64_t );
+		__DEFINE_Box( Float , float );
+		__DEFINE_Box( Double , double );
+		__DEFINE_Box( Byte , byte );
+		__DEFINE_Box( SByte , sbyte );
+		__DEFINE_Box( Bool , bool );
+	#undef __DEFINE_Box
+		template<typename T> forceinline P<Object> Box( const P<T>& v ) { return v; }
+	}
 #pragma endregion
 
 
@@ -571,10 +2194,13 @@ UCEndInterface
 
 
 #pragma region Integral Conversion Functions
-#define __DEFINE_asTForLowerHelper(r, data, i, elem) if ( auto res = ObjCast<elem>( it ) ) return static_cast<data>(res->value);
+#define __DEFINE_asTForLowerHelper(r, data, i, elem) case NumKind::elem: return static_cast<data>(static_cast<const elem&>(*it).value);
 #define __DEFINE_asTForLower(curr, name, ...) \
 static curr as##name(const P<Object>& it , const char* msg){\
-	BOOST_PP_SEQ_FOR_EACH_I(__DEFINE_asTForLowerHelper, curr, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))\
+	if ( it != nullptr ) switch ( it->GetNumKind( ) ){\
+		BOOST_PP_SEQ_FOR_EACH_I(__DEFINE_asTForLowerHelper, curr, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))\
+		default: break;\
+	}\
 	throw InvalidCastException(msg);\
 }
 	__DEFINE_asTForLower( int16_t , Int16 , Int16 , Byte , SByte );
@@ -587,29 +2213,111 @@ static curr as##name(const P<Object>& it , const char* msg){\
 	__DEFINE_asTForLower( sbyte , SByte , SByte );
 
 
-	__DEFINE_asTForLower( float , Float , UInt64 , Int64 , Int64 , UInt32 , Int32 , UInt16 , Int16 , Byte , SByte );
-	__DEFINE_asTForLower( double , Double , Float , UInt64 , Int64 , Int64 , UInt32 , Int32 , Int16 , UInt16 , Byte , SByte );
+	__DEFINE_asTForLower( float , Float , Float , UInt64 , Int64 , UInt32 , Int32 , UInt16 , Int16 , Byte , SByte );
+	__DEFINE_asTForLower( double , Double , Double , Float , UInt64 , Int64 , UInt32 , Int32 , Int16 , UInt16 , Byte , SByte );
 #undef __DEFINE_asTForLowerHelper
 #undef __DEFINE_asTForLower
 #pragma endregion
 
 
+#pragma region Unboxing
+	namespace _Detail
+	{
+		template<typename R> R Unbox( const P<Object>& v )
+		{
+			static const NatString msg = ConcatNatStrings( "The value isn't of a type that can be converted to " , SGetTypeName<R>( ) , "." );
+			if constexpr ( std::is_same_v<R , int16_t> ) return asInt16( v , msg.c_str( ) );
+			else if constexpr ( std::is_same_v<R , int32_t> ) return asInt32( v , msg.c_str( ) );
+			else if constexpr ( std::is_same_v<R , int64_t> ) return asInt64( v , msg.c_str( ) );
+			else if constexpr ( std::is_same_v<R , uint16_t> ) return asUInt16( v , msg.c_str( ) );
+			else if constexpr ( std::is_same_v<R , uint32_t> ) return asUInt32( v , msg.c_str( ) );
+			else if constexpr ( std::is_same_v<R , uint64_t> ) return asUInt64( v , msg.c_str( ) );
+			else if constexpr ( std::is_same_v<R , float> ) return asFloat( v , msg.c_str( ) );
+			else if constexpr ( std::is_same_v<R , double> ) return asDouble( v , msg.c_str( ) );
+			else if constexpr ( std::is_same_v<R , byte> ) return asByte( v , msg.c_str( ) );
+			else if constexpr ( std::is_same_v<R , sbyte> ) return asSByte( v , msg.c_str( ) );
+			else if constexpr ( std::is_same_v<R , bool> ) return ObjCastThrowingNatStr<Bool>( v , msg )->value;
+			else
+			{
+				static_assert( IsGCPtr<R>::value , "CallAs can only return the native types of the boxed primitives or a P<T>." );
+				return v == nullptr ? R( ) : ObjCastThrowingNatStr<typename IsGCPtr<R>::element_type>( v , msg );
+			}
+		}
+
+		// Moves the result of a call into the returned P<T> instead of copying it.
+		template<typename R> R Unbox( P<Object>&& v )
+		{
+			if constexpr ( IsGCPtr<R>::value )
+			{
+				static const NatString msg = ConcatNatStrings( "The value isn't of a type that can be converted to " , SGetTypeName<R>( ) , "." );
+				return v == nullptr ? R( ) : ObjCastThrowingNatStr<typename IsGCPtr<R>::element_type>( std::move( v ) , msg );
+			}
+			else return Unbox<R>( static_cast< const P<Object>& >( v ) );
+		}
+	}
+#pragma endregion
+
+
 #pragma region String
+	/// <summary>
+	/// The instruction sets that the String search kernels can use, the best one supported by the CPU is chosen at runtime.
+	/// </summary>
+	enum class SimdLevel : uint8_t
+	{
+		Scalar ,
+		SSE2 ,
+		AVX2
+	};
+
+	namespace _Detail
+	{
+		// The String search kernels, in Object.cpp.
+		SimdLevel GetSimdLevel( ) noexcept;
+		SimdLevel SetSimdLevel( SimdLevel level ) noexcept;
+		/// <summary>
+		/// Gets the index of the first c in data, or std::string_view::npos.
+		/// </summary>
+		size_t FindByte( const char* data , size_t size , char c ) noexcept;
+		size_t CountByte( const char* data , size_t size , char c ) noexcept;
+		/// <summary>
+		/// Gets the index of the first needle in haystack from pos, or std::string_view::npos.
+		/// </summary>
+		size_t FindSubstring( std::string_view haystack , std::string_view needle , size_t pos = 0 ) noexcept;
+		/// <summary>
+		/// Counts the non-overlapping needles in haystack, an empty needle isn't counted.
+		/// </summary>
+		size_t CountSubstring( std::string_view haystack , std::string_view needle ) noexcept;
+		bool EqualBytes( const char* a , const char* b , size_t size ) noexcept;
+	}
+
 	/// <summary>
 	/// Represents text as a non-mutable sequence of ASCII code units.
+	/// Concatenations of long Strings are ropes, that only refer to the Strings concatenated,
+	/// the characters are copied once, when they are first accessed.
+	/// Long substrings are views, that refer to the characters of the String they were taken from.
 	/// </summary>
 	UCInterface( String , UC_WhereTypenameIs( "UC::String" ) , UC_InheritsUCClasses( Object ) ,
 				 UC_InheritsNoNativeClasses , final );
-	UC_HasNativeCtorsAndEmptyCtor;
+	// Like UC_HasNativeCtorsAndEmptyCtor, but every empty String made is the shared empty String.
+	template<typename... Args>
+	static NotNull<pself> Make( Args&&... args ) { return MakeFrom( str_t( std::forward<Args>( args )... ) ); }
+	__UCDefineMakeWith
+	static P<Object> make_reflective( ArgSpan args )
+	{
+		if ( args.size( ) == 0 ) return Make( );
+		throw NoSuchConstructor_Exception( ConcatNatStrings( "No constructor for type \"" , SGetTypeName( ) , "\" that takes in " , std::to_string( args.size( ) ) , " parameters." ) );
+	}
 	UC_HasMethods(
-		( ULength ) ,
-		( UContains , ( s ) ) ,
-		( UEndsWith , ( s ) ) ,
-		( UStartsWith , ( s ) ) ,
-		( UEquals , ( s ) ) ,
+		( ULength , ( ) , int64_t ) ,
+		( UContains , ( s ) , bool ) ,
+		( UEndsWith , ( s ) , bool ) ,
+		( UStartsWith , ( s ) , bool ) ,
+		( UEquals , ( s ) , bool ) ,
+		( UIndexOf , ( s ) , int64_t ) ,
+		( UCount , ( s ) , int64_t ) ,
 		( USubstring , ( startIdx ) ) ,
 		( USubstring , ( startIdx , count ) ) ,
-		( Get , ( Idx ) ) ,
+		( Get , ( Idx ) , byte ) ,
 		( OpAdd , ( _1 ) ) ,
 		( OpAdd , ( _1 , _2 ) ) ,
 		( OpAdd , ( _1 , _2 , _3 ) ) ,
@@ -627,63 +2335,216 @@ public:
 	using value_type = char;
 	using reference = char &;
 	using const_reference = const char&;
-	using iterator = typename str_t::const_iterator;
-	using const_iterator = typename str_t::const_iterator;
-	using reverse_iterator = typename str_t::const_reverse_iterator;
-	using const_reverse_iterator = typename str_t::const_reverse_iterator;
-
-	const str_t value;
-
-	forceinline iterator begin( ) { return std::begin( value ); }
-	forceinline const_iterator begin( ) const { return std::begin( value ); }
-	forceinline iterator end( ) { return std::end( value ); }
-	forceinline const_iterator end( ) const { return std::end( value ); }
-	forceinline const_iterator cbegin( ) const { return std::cbegin( value ); }
-	forceinline const_iterator cend( ) const { return std::cend( value ); }
-
-	forceinline reverse_iterator rbegin( ) { return std::rbegin( value ); }
-	forceinline const_reverse_iterator rbegin( ) const { return std::rbegin( value ); }
-	forceinline reverse_iterator rend( ) { return std::rend( value ); }
-	forceinline const_reverse_iterator rend( ) const { return std::rend( value ); }
-	forceinline const_reverse_iterator crbegin( ) const { return std::crbegin( value ); }
-	forceinline const_reverse_iterator crend( ) const { return std::crend( value ); }
-
-	NatString ToString( ) const override { return ConcatNatStrings( "\"" , value , "\"" ); }
-	int64_t GetHashCode( ) const override { return Hash( value ); }
-
-	forceinline const char& Get( size_t idx ) const { return value[ ( size_t ) idx ]; }
-
-	forceinline int64_t NLength( ) const noexcept { return value.length( ); }
-
-	forceinline bool NContains( const pself& s )const { return ( s->NLength( ) == 0 ) || boost::contains( value , s->value ); }
-	forceinline bool NEndsWith( const pself& s )const { return ( s->NLength( ) == 0 ) || boost::ends_with( value , s->value ); }
-	forceinline bool NStartsWith( const pself& s )const { return ( s->NLength( ) == 0 ) || boost::starts_with( value , s->value ); }
-	forceinline bool NEquals( const pself& s )const { return value == s->value; }
-	forceinline size_t NGetHashCode( ) const { return std::hash<std::string>( )( value ); }
-	forceinline pself NSubstring( size_t startIndex , size_t length ) const { return Make( value.substr( startIndex , length ) ); }
-	forceinline pself NSubstring( size_t startIndex ) const { return Make( value.substr( startIndex ) ); }
-
-	forceinline pself operator+( const self& s )const { return Make( value + s.value ); }
-	forceinline bool operator==( const self& s ) const { return value == s.value; }
-	forceinline bool operator!=( const self& s ) const { return value != s.value; }
-	forceinline bool operator==( const char* s ) const { return value == s; }
-	forceinline bool operator!=( const char* s ) const { return value != s; }
+	using iterator = typename std::string_view::const_iterator;
+	using const_iterator = typename std::string_view::const_iterator;
+	using reverse_iterator = typename std::string_view::const_reverse_iterator;
+	using const_reverse_iterator = typename std::string_view::const_reverse_iterator;
+
+	/// <summary>
+	/// Gets the characters of the String, copying them out of the rope or the String viewed first if needed.
+	/// Prefer View, which doesn't copy the characters of a view.
+	/// </summary>
+	forceinline const str_t& Value( ) const
+	{
+		if ( !isFlat( ) ) flatten( );
+		return value;
+	}
+	/// <summary>
+	/// Gets the characters of the String, copying them out of the rope first if it is one.
+	/// </summary>
+	forceinline std::string_view View( ) const
+	{
+		if ( isFlat( ) ) return value;
+		// The String viewed is always flat & never changed.
+		if ( lazy->parent != nullptr ) return std::string_view( lazy->parent->value ).substr( lazy->offset , charCount( ) );
+		flatten( );
+		return value;
+	}
+
+	forceinline iterator begin( ) { return View( ).begin( ); }
+	forceinline const_iterator begin( ) const { return View( ).begin( ); }
+	forceinline iterator end( ) { return View( ).end( ); }
+	forceinline const_iterator end( ) const { return View( ).end( ); }
+	forceinline const_iterator cbegin( ) const { return View( ).cbegin( ); }
+	forceinline const_iterator cend( ) const { return View( ).cend( ); }
 
+	forceinline reverse_iterator rbegin( ) { return View( ).rbegin( ); }
+	forceinline const_reverse_iterator rbegin( ) const { return View( ).rbegin( ); }
+	forceinline reverse_iterator rend( ) { return View( ).rend( ); }
+	forceinline const_reverse_iterator rend( ) const { return View( ).rend( ); }
+	forceinline const_reverse_iterator crbegin( ) const { return View( ).crbegin( ); }
+	forceinline const_reverse_iterator crend( ) const { return View( ).crend( ); }
+
+	NatString ToString( ) const override { return ConcatNatStrings( "\"" , View( ) , "\"" ); }
+	int64_t GetHashCode( ) const override { return NGetHashCode( ); }
+
+	forceinline const char& Get( size_t idx ) const { return View( )[ ( size_t ) idx ]; }
+
+	forceinline int64_t NLength( ) const noexcept { return charCount( ); }
+	/// <summary>
+	/// Checks whether the String is a rope whose characters haven't been copied out yet.
+	/// </summary>
+	forceinline bool IsRope( ) const noexcept { return lazy != nullptr && lazy->parent == nullptr && !lazy->flat.load( std::memory_order_acquire ); }
+	/// <summary>
+	/// Checks whether the String is the one in the intern table, see Intern.
+	/// </summary>
+	forceinline bool IsInterned( ) const noexcept { return interned.load( std::memory_order_relaxed ); }
+	/// <summary>
+	/// Checks whether the String is a view of the characters of another String, which it keeps alive.
+	/// </summary>
+	forceinline bool IsView( ) const noexcept { return lazy != nullptr && lazy->parent != nullptr; }
+
+	forceinline bool NContains( const pself& s )const { return _Detail::FindSubstring( View( ) , s->View( ) ) != std::string_view::npos; }
+	forceinline bool NEndsWith( const pself& s )const
+	{ return s->charCount( ) <= charCount( ) && _Detail::EqualBytes( View( ).data( ) + charCount( ) - s->charCount( ) , s->View( ).data( ) , s->charCount( ) ); }
+	forceinline bool NStartsWith( const pself& s )const
+	{ return s->charCount( ) <= charCount( ) && _Detail::EqualBytes( View( ).data( ) , s->View( ).data( ) , s->charCount( ) ); }
+	/// <summary>
+	/// Gets the index of the first s in the String from startIndex, or -1 if there is none.
+	/// </summary>
+	forceinline int64_t NIndexOf( const pself& s , size_t startIndex = 0 ) const
+	{
+		const auto idx = _Detail::FindSubstring( View( ) , s->View( ) , startIndex );
+		return idx == std::string_view::npos ? -1 : static_cast< int64_t >( idx );
+	}
+	forceinline int64_t NIndexOf( char c , size_t startIndex = 0 ) const
+	{
+		const auto chars = View( );
+		if ( startIndex >= chars.size( ) ) return -1;
+		const auto idx = _Detail::FindByte( chars.data( ) + startIndex , chars.size( ) - startIndex , c );
+		return idx == std::string_view::npos ? -1 : static_cast< int64_t >( startIndex + idx );
+	}
+	/// <summary>
+	/// Counts the non-overlapping s in the String, an empty s is counted 0 times.
+	/// </summary>
+	forceinline int64_t NCount( const pself& s ) const { return static_cast< int64_t >( _Detail::CountSubstring( View( ) , s->View( ) ) ); }
+	forceinline int64_t NCount( char c ) const
+	{
+		const auto chars = View( );
+		return static_cast< int64_t >( _Detail::CountByte( chars.data( ) , chars.size( ) , c ) );
+	}
+	/// <summary>
+	/// Gets the instruction set used by the search kernels of NContains, NStartsWith, NEndsWith, NIndexOf & NCount.
+	/// </summary>
+	static forceinline SimdLevel GetSimdLevel( ) noexcept { return _Detail::GetSimdLevel( ); }
+	/// <summary>
+	/// Sets the instruction set used by the search kernels, limited to the best one supported by the CPU, returns the one set.
+	/// </summary>
+	static forceinline SimdLevel SetSimdLevel( SimdLevel level ) noexcept { return _Detail::SetSimdLevel( level ); }
+	forceinline bool NEquals( const pself& s )const { return *this == *s; }
+	/// <summary>
+	/// Gets the hash code of the characters, it is computed by the first call & cached in the String.
+	/// </summary>
+	forceinline size_t NGetHashCode( ) const
+	{
+		auto hash = hashCode.load( std::memory_order_relaxed );
+		// A hash code of 0 is recomputed every time, which is harmless as it is rare.
+		if ( hash == 0 ) hashCode.store( hash = std::hash<std::string_view>( )( View( ) ) , std::memory_order_relaxed );
+		return hash;
+	}
+	/// <summary>
+	/// Gets the characters from startIndex, the result is a view of the characters of this String,
+	/// without copying them, if it has at least UC_STRING_VIEW_MIN_LENGTH characters.
+	/// </summary>
+	pself NSubstring( size_t startIndex , size_t count ) const;
+	forceinline pself NSubstring( size_t startIndex ) const { return NSubstring( startIndex , std::string_view::npos ); }
+
+	forceinline pself operator+( const self& s )const { return mutableFrom( join( ME , s.ME ) ); }
+	bool operator==( const self& s ) const
+	{
+		if ( this == &s ) return true;
+		// There is only 1 interned String with the same characters.
+		if ( charCount( ) != s.charCount( ) || ( IsInterned( ) && s.IsInterned( ) ) ) return false;
+		const auto hash = hashCode.load( std::memory_order_relaxed ) , sHash = s.hashCode.load( std::memory_order_relaxed );
+		if ( hash != 0 && sHash != 0 && hash != sHash ) return false;
+		return _Detail::EqualBytes( View( ).data( ) , s.View( ).data( ) , charCount( ) );
+	}
+	forceinline bool operator!=( const self& s ) const { return !( *this == s ); }
+	forceinline bool operator==( const char* s ) const { return View( ) == s; }
+	forceinline bool operator!=( const char* s ) const { return View( ) != s; }
+
+	/// <summary>
+	/// Concatenates args, which can be Strings or native strings.
+	/// The result is a rope if it has at least UC_STRING_ROPE_MIN_LENGTH characters.
+	/// </summary>
 	template<typename... Args> static pself Concat( Args&&... args )
-	{ return Make( ConcatNatStrings( GetNativeFrom( GetFrom( std::forward<Args>( args ) ) )... ) ); }
+	{ return ConcatI( { pcself( GetFrom( std::forward<Args>( args ) ) )... } ); }
+	static pself ConcatI( std::initializer_list<pcself> args );
+
+	/// <summary>
+	/// Gets the interned String with the same characters as s, s itself is interned if there isn't one.
+	/// Equal interned Strings are the same object, so they are compared by their address.
+	/// Interned Strings are kept alive until the end of the program.
+	/// </summary>
+	static NotNull<pself> Intern( const pself& s );
+	/// <summary>
+	/// Gets the interned String with the characters of s, a String is made & interned if there isn't one.
+	/// </summary>
+	static NotNull<pself> Intern( std::string_view s );
+	/// <summary>
+	/// Gets the interned String with the characters of s, or nullptr if there isn't one.
+	/// </summary>
+	static pself FindInterned( std::string_view s );
+
+	/// <summary>
+	/// Gets the shared empty String.
+	/// </summary>
+	static const pself& GetEmpty( )
+	{
+		static const pself empty = ::UC::_Detail::MakeGC<self>( );
+		return empty;
+	}
+	/// <summary>
+	/// Makes an empty String, which is always the shared empty String.
+	/// </summary>
+	forceinline static NotNull<pself> Make( ) { return NotNull<pself>::Unchecked( GetEmpty( ) ); }
+	/// <summary>
+	/// Makes a String that holds v, reusing the shared empty String if v is empty.
+	/// </summary>
+	forceinline static NotNull<pself> MakeFrom( str_t&& v ) { return v.empty( ) ? Make( ) : ::UC::_Detail::MakeGC<self>( std::move( v ) ); }
 
 	static pself GetFrom( self& s ) { return s.ME; }
 	static pcself GetFrom( const self& s ) { return s.ME; }
 	static pself GetFrom( self&& s ) { return s.ME; }
 	static const pself& GetFrom( const pself& s ) { return s; }
 	static pcself GetFrom( const pcself& s ) { return s; }
-	static pself GetFrom( str_t&& s ) { return Make( s ); }
+	static pself GetFrom( str_t&& s ) { return MakeFrom( std::move( s ) ); }
 	static pself GetFrom( const str_t& s ) { return Make( s ); }
 	static pself GetFrom( const char* s ) { return Make( s ); }
-	static const str_t& GetNativeFrom( const pself& s ) { return s->value; }
-	static const str_t& GetNativeFrom( const P<const self>& s ) { return s->value; }
+	static const str_t& GetNativeFrom( const pself& s ) { return s->Value( ); }
+	static const str_t& GetNativeFrom( const P<const self>& s ) { return s->Value( ); }
 
 private:
+	struct RopeTag { };
+	struct ViewTag { };
+
+	// The state of a rope or a view, kept out of line so that flat Strings only pay a pointer for it.
+	struct Lazy
+	{
+		// The rope children, released once the String is flattened.
+		pcself left , right;
+		// The flat String that a view refers to, kept even if value is copied from it.
+		const pcself parent;
+		// The index of the first character of a view in parent.
+		const size_t offset;
+		const size_t length;
+		// The depth of the rope, 0 for views.
+		const uint8_t depth;
+		// Set once value holds the characters, until then they are in the rope children or in parent.
+		std::atomic<bool> flat { false };
+
+		Lazy( size_t length , uint8_t depth , pcself&& parent = nullptr , size_t offset = 0 ) noexcept :
+			parent( std::move( parent ) ) , offset( offset ) , length( length ) , depth( depth ) { }
+	};
+
+	// Empty while the String is a rope or a view that hasn't been flattened, never changed otherwise.
+	mutable str_t value;
+	// 0 until NGetHashCode is first called.
+	mutable std::atomic<size_t> hashCode { 0 };
+	// Only set for ropes & views, a String created flat is always flat.
+	const std::unique_ptr<Lazy> lazy;
+	mutable std::atomic<bool> interned { false };
+
 	forceinline String( const std::string_view& v ) :value( v ) { }
 	forceinline String( const str_t& v ) : value( v ) { }
 	forceinline String( str_t&& v ) : value( std::move( v ) ) { }
@@ -692,6 +2553,115 @@ private:
 	template<typename Iter> String( Iter beg , Iter end ) : value( beg , end ) { }
 	forceinline String( const char* value_ ) : value( value_ ) { }
 	forceinline String( const char* value_ , size_t startIndex , size_t length ) : value( value_ , startIndex , length ) { }
+	String( RopeTag , pcself&& l , pcself&& r );
+	String( ViewTag , pcself&& root , size_t offset_ , size_t length_ );
+
+	/// <summary>
+	/// Copies the characters of the rope into value & releases its children, or copies the characters of the view into value.
+	/// </summary>
+	void flatten( ) const;
+	/// <summary>
+	/// Gets the rope children, returns false if the String is flat.
+	/// </summary>
+	bool children( pcself& l , pcself& r ) const;
+	forceinline uint8_t ropeDepth( ) const noexcept { return isFlat( ) ? 0 : lazy->depth; }
+	forceinline bool isFlat( ) const noexcept { return lazy == nullptr || lazy->flat.load( std::memory_order_acquire ); }
+	forceinline size_t charCount( ) const noexcept { return lazy != nullptr ? lazy->length : value.size( ); }
+	/// <summary>
+	/// Concatenates l & r, keeping the rope balanced like an AVL tree, so its depth is logarithmic in the number of pieces.
+	/// </summary>
+	static pcself join( pcself l , pcself r );
+	static pcself joinFlat( const pcself& l , const pcself& r );
+	static pcself makeRope( pcself&& l , pcself&& r );
+	// Strings are immutable, so a String that was passed as const can be handed out as non-const.
+	static forceinline pself mutableFrom( const pcself& s ) { return const_cast< self& >( *s ).ME; }
+	UCEndInterface;
+#pragma endregion
+
+
+#pragma region StringBuilder
+	/// <summary>
+	/// Builds text in a growable buffer, which is moved into the String made by NToString, without copying it.
+	/// </summary>
+	UCInterface( StringBuilder , UC_WhereTypenameIs( "UC::StringBuilder" ) , UC_InheritsUCClasses( Object ) ,
+				 UC_InheritsNoNativeClasses , final );
+	UC_HasNativeCtorsAndEmptyCtor;
+	UC_HasMethods(
+		( UAppend , ( v ) ) ,
+		( UAppendLine ) ,
+		( UAppendLine , ( v ) ) ,
+		( UReserve , ( capacity ) ) ,
+		( ULength , ( ) , int64_t ) ,
+		( UToString )
+	);
+public:
+	using str_t = NatString;
+
+	forceinline self& Append( std::string_view s )
+	{
+		grow( s.size( ) );
+		buffer.append( s );
+		return *this;
+	}
+	forceinline self& Append( const char* s ) { return Append( std::string_view( s ) ); }
+	forceinline self& Append( const str_t& s ) { return Append( std::string_view( s ) ); }
+	forceinline self& Append( const P<String>& s ) { return Append( s->View( ) ); }
+	forceinline self& Append( char c )
+	{
+		grow( 1 );
+		buffer.push_back( c );
+		return *this;
+	}
+	forceinline self& Append( bool v ) { return Append( v ? std::string_view( "true" ) : std::string_view( "false" ) ); }
+	/// <summary>
+	/// Appends the shortest representation of the number v, without allocating.
+	/// </summary>
+	template<typename T , std::enable_if_t<std::is_integral_v<T> || std::is_floating_point_v<T> , int> = 0>
+	self& Append( T v )
+	{
+		char chars[ 32 ];
+		const auto result = std::to_chars( chars , chars + sizeof( chars ) , v );
+		return Append( std::string_view( chars , result.ptr - chars ) );
+	}
+	/// <summary>
+	/// Appends v->ToString( ), or the digits of v without allocating if it is a boxed integer.
+	/// </summary>
+	self& Append( const P<Object>& v );
+	template<typename T> forceinline self& AppendLine( T&& v ) { return Append( std::forward<T>( v ) ).Append( '\n' ); }
+	forceinline self& AppendLine( ) { return Append( '\n' ); }
+
+	forceinline void Reserve( size_t capacity ) { buffer.reserve( capacity ); }
+	forceinline void Clear( ) noexcept { buffer.clear( ); }
+	forceinline int64_t NLength( ) const noexcept { return buffer.size( ); }
+	forceinline size_t Capacity( ) const noexcept { return buffer.capacity( ); }
+	forceinline std::string_view View( ) const noexcept { return buffer; }
+
+	/// <summary>
+	/// Moves the characters into a new String, without copying them, & leaves the StringBuilder empty.
+	/// </summary>
+	NotNull<P<String>> NToString( )
+	{
+		auto str = String::MakeFrom( std::move( buffer ) );
+		buffer.clear( );
+		return str;
+	}
+	/// <summary>
+	/// Copies the characters, the StringBuilder is left as it is.
+	/// </summary>
+	NatString ToString( ) const override { return buffer; }
+
+private:
+	str_t buffer;
+
+	// Doubles the capacity when it runs out, so appending is amortized O(1) whatever the growth of str_t is.
+	forceinline void grow( size_t extra )
+	{
+		if ( buffer.size( ) + extra > buffer.capacity( ) ) buffer.reserve( std::max( buffer.size( ) + extra , buffer.capacity( ) * 2 ) );
+	}
+
+	forceinline StringBuilder( ) : buffer( ) { }
+	forceinline StringBuilder( size_t capacity ) : buffer( ) { buffer.reserve( capacity ); }
+	forceinline StringBuilder( std::string_view s ) : buffer( s ) { }
 	UCEndInterface;
 #pragma endregion
 
@@ -712,6 +2682,7 @@ UCTemplateInterface( name , ( T ) , UC_WhereTypenameIs( "UC::" __ToString(name)
 		( OpRemAt , ( idx ) )\
 	);\
 \
+	UC_HasGCEdges( coll );\
 public:\
 	using col_t = underly_t<T>;\
 	col_t coll;\
@@ -900,7 +2871,9 @@ public:\
 		coll.erase( begin( ) + index );\
 	}\
 	template<typename... Args>\
-	pself MakeI(Args&&... args){return pself(new self{std::forward<Args>(args)...});}\
+	static pself MakeI(Args&&... args){return ::UC::_Detail::MakeGC<self>(std::initializer_list<T>{std::forward<Args>(args)...});}\
+	template<typename TAlloc, typename... Args>\
+	static pself MakeIWith(const TAlloc& alloc, Args&&... args){return ::UC::_Detail::AllocateGC<self>(alloc, std::initializer_list<T>{std::forward<Args>(args)...});}\
 protected:\
 	inline name( uint64_t len ) : coll( len ) { }\
 	template<typename TIter>\
@@ -944,6 +2917,7 @@ UCMethod( name<_T>::OpRemAt , ( idx ) ) { RemoveAt( UCAsUInt64( idx ) ); return
 UCTemplateInterface( name , ( TKey , TVal ) , UC_WhereTypenameIs( "UC::" __ToString(name) ) , UC_InheritsUCClasses( Object ) , UC_InheritsNoNativeClasses );\
 	UC_HasNativeCtorsAndEmptyCtor;\
 	UC_HasMethods( ( OpClear ) , ( OpSize ) , ( OpLen ) );\
+	UC_HasGCEdges( coll );\
 public:\
 	using coll_t = underly_t<TKey , TVal, Hasher<TKey>>;\
 	coll_t coll;\
@@ -1033,8 +3007,9 @@ public:\
 		return true;\
 	}\
 \
-	template<typename... Args>\
-	static pself MakeI(std::initializer_list<std::pair<const TKey , TVal>> ilist){return pself(new self(ilist));}\
+	static pself MakeI(std::initializer_list<std::pair<const TKey , TVal>> ilist){return ::UC::_Detail::MakeGC<self>(ilist);}\
+	template<typename TAlloc>\
+	static pself MakeIWith(const TAlloc& alloc, std::initializer_list<std::pair<const TKey , TVal>> ilist){return ::UC::_Detail::AllocateGC<self>(alloc, ilist);}\
 \
 UCEndInterface;\
 \
@@ -1051,6 +3026,79 @@ UC_MTPMethod( ( name<TKey , TVal> ) , OpLen ) { return Int64::Make( Size( ) ); }
 #pragma endregion
 #pragma endregion
 
+
+#pragma region Batch Calls
+	enum class Execution
+	{
+		Sequential , Parallel
+	};
+
+	namespace _Detail
+	{
+		/// <summary>
+		/// Resolves a method once for every dynamic type, indexed by the dense type IDs.
+		/// </summary>
+		class BatchResolver
+		{
+			const MethodRef fname;
+			const size_t arity;
+			NatVector<const MethodEntry*> methods;
+
+			const MethodEntry* resolveSlow( Object& obj );
+		public:
+			BatchResolver( Selector fname , size_t arity ) :fname( fname ) , arity( arity ) { }
+
+			forceinline const MethodEntry* Resolve( Object& obj )
+			{
+				const auto id = obj.TypeId( );
+				if ( id < methods.size( ) && methods[ id ] != nullptr ) return methods[ id ];
+				return resolveSlow( obj );
+			}
+		};
+
+		// Splits [0, count) into contiguous chunks & runs them on a thread each, rethrows the first exception thrown by any chunk.
+		void RunInParallel( size_t count , const std::function<void( size_t from , size_t to )>& body );
+	}
+
+	/// <summary>
+	/// Calls the method fname with the arguments args on every element of range, which may be any range of P&lt;T&gt;s, e.g. a UC::Vector or a NatOVector.
+	/// The method is resolved once for every dynamic type in the range instead of once for every element.
+	/// With Execution::Parallel large ranges are split across the cores, so the method must be safe to call concurrently.
+	/// Returns the results in the order of the elements.
+	/// </summary>
+	template<typename TRange>
+	NatOVector CallEach( const TRange& range , Selector fname , ArgSpan args , Execution execution = Execution::Sequential )
+	{
+		using std::begin;
+		using std::end;
+		const auto first = begin( range );
+		const size_t count = std::distance( first , end( range ) );
+		NatOVector results( count );
+		auto run = [ & ] ( size_t from , size_t to )
+		{
+			_Detail::BatchResolver resolver( fname , args.size( ) );
+			auto itr = std::next( first , from );
+			for ( size_t i = from; i < to; ++i , ++itr )
+			{
+				Object& obj = *itr->Get( ).ptr;
+				results[ i ] = resolver.Resolve( obj )->thunk( obj , args );
+			}
+		};
+		if ( execution == Execution::Parallel ) _Detail::RunInParallel( count , run );
+		else run( 0 , count );
+		return results;
+	}
+	template<typename TRange>
+	forceinline NatOVector CallEach( const P<TRange>& range , Selector fname , ArgSpan args , Execution execution = Execution::Sequential )
+	{ return CallEach( *range , fname , args , execution ); }
+	template<typename TRange>
+	forceinline NatOVector CallEach( const NotNull<P<TRange>>& range , Selector fname , ArgSpan args , Execution execution = Execution::Sequential )
+	{ return CallEach( *range , fname , args , execution ); }
+	template<typename TRange>
+	forceinline NatOVector CallEach( const TRange& range , Selector fname , std::initializer_list<P<Object>> args , Execution execution = Execution::Sequential )
+	{ return CallEach( range , fname , ArgSpan( args.begin( ) , args.size( ) ) , execution ); }
+#pragma endregion
+
 	template<typename T , typename TFunctionToUse = void> struct _FunctionTypeDeducerImpl;
 
 	template<typename TAssign , typename TFunc>
@@ -1101,6 +3149,7 @@ protected:
 	UCTemplateInterfaceWithPack( Event , ( TReturn ) , TParams , UC_WhereTypenameIs( "UC::Event" ) , UC_InheritsUCClassesInBraces( ( Functor<TReturn , TParams...> ) ) , UC_InheritsNoNativeClasses , final );
 	UC_OnlyHasNativeCtors;
 	UC_HasNoMethods;
+	UC_HasGCEdges( lst );
 
 	using func_t = P<Functor<TReturn , TParams...>>;
 
@@ -1256,7 +3305,7 @@ struct _FunctionTypeDeducerImpl<__VA_ARGS__>\
 
 		template<typename T>
 		forceinline size_t operator()( const T& val , std::false_type ) const
-		{ return std::hash<std::shared_ptr<typename T::element_type>>( )( val.ptr ); }
+		{ return std::hash<decltype( val.ptr )>( )( val.ptr ); }
 	};
 
 	namespace IntLiterals
@@ -1291,7 +3340,7 @@ struct _FunctionTypeDeducerImpl<__VA_ARGS__>\
 
 	namespace StrLiterals
 	{
-		forceinline static P<String> operator""_us( const char* param , std::size_t ) { return String::Make( param ); }
+		forceinline static P<String> operator""_us( const char* param , std::size_t len ) { return len == 0 ? String::GetEmpty( ) : String::Make( param ); }
 	}
 
 	namespace AnalogLiterals
@@ -1352,9 +3401,14 @@ namespace std
 		___UC_NODISCARD___ size_t operator()( const UC::GCPtr<T> v ) const noexcept { return UC::_HashGCP( )( v ); }
 	};
 
+	template<typename T> struct hash<UC::NotNull<UC::GCPtr<T>>> :hash<UC::GCPtr<T>> { };
+
 	template<typename T> inline ostream& operator<<( ostream& o , const UC::GCPtr<T>& p )
 	{ return o << to_string( *p ); }
 
+	static inline ostream& operator<<( ostream& o , const UC::Selector& sel )
+	{ return o << sel.Name( ); }
+
 	static inline ostream& operator<<( ostream& o , nullptr_t )
 	{ return o << "nullptr"; }
 